@@ -4,6 +4,13 @@
 #include "CMenu.h"
 
 #include "Kismet/KismetSystemLibrary.h"
+#include "Blueprint/WidgetTree.h"
+#include "Components/InvalidationBox.h"
+#include "VRProject.h"
+#include "VRMenuSubsystem.h"
+
+DECLARE_CYCLE_STAT(TEXT("Menu Widget Paint"), STAT_VR_MenuPaint, STATGROUP_VRProject);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Menu Widget Paints"), STAT_VRMenuPaints, STATGROUP_VRProject);
 
 void UCMenu::QuitVRGame()
 {
@@ -13,3 +20,53 @@ void UCMenu::QuitVRGame()
 		UKismetSystemLibrary::QuitGame(GetWorld(), PC, EQuitPreference::Quit, true);
 	}
 }
+
+void UCMenu::RequestRedraw()
+{
+	if(auto Menu = GetWorld() ? GetWorld()->GetSubsystem<UVRMenuSubsystem>() : nullptr)
+	{
+		Menu->RequestRedraw(this);
+	}
+}
+
+void UCMenu::NativeOnInitialized()
+{
+	Super::NativeOnInitialized();
+
+	// 위젯 트리 전체를 Invalidation Box로 감싸서 바뀌지 않은 부분은 캐시된 그리기 결과를 쓴다.
+	if(IsDesignTime() == false && WidgetTree && WidgetTree->RootWidget && WidgetTree->RootWidget->IsA<UInvalidationBox>() == false)
+	{
+		UWidget* Content = WidgetTree->RootWidget;
+		UInvalidationBox* InvalidationBox = WidgetTree->ConstructWidget<UInvalidationBox>(UInvalidationBox::StaticClass(), TEXT("MenuInvalidationBox"));
+		InvalidationBox->SetCanCache(true);
+		WidgetTree->RootWidget = InvalidationBox;
+		InvalidationBox->SetContent(Content);
+	}
+}
+
+void UCMenu::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+{
+	Super::NativeTick(MyGeometry, InDeltaTime);
+
+	// 애니메이션이 끝날 때까지는 계속 다시 그린다.
+	if(IsAnyAnimationPlaying())
+	{
+		RequestRedraw();
+	}
+}
+
+int32 UCMenu::NativePaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_VR_MenuPaint);
+	INC_DWORD_STAT(STAT_VRMenuPaints);
+	CSV_SCOPED_TIMING_STAT(VRProject, MenuPaint);
+
+	return Super::NativePaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, LayerId, InWidgetStyle, bParentEnabled);
+}
+
+void UCMenu::OnAnimationStartedPlaying(UUMGSequencePlayer& Player)
+{
+	Super::OnAnimationStartedPlaying(Player);
+
+	RequestRedraw();
+}
@@ -0,0 +1,345 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "VRActorPoolSubsystem.h"
+#include "VRPoolableActor.h"
+#include "VRProject.h"
+#include "TimerManager.h"
+#include "Engine/AssetManager.h"
+#include "Engine/Engine.h"
+#include "UObject/UObjectGlobals.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pooled Actors Active"), STAT_VRPoolActive, STATGROUP_VRProject);
+
+static TAutoConsoleVariable<int32> CVarActorPoolEnabled(
+	TEXT("vr.ActorPool.Enabled"),
+	1,
+	TEXT("0: Acquire spawns a new actor every time and Release destroys it (for pooled/unpooled session comparisons)."));
+
+bool UVRActorPoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UVRActorPoolSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// 맵 시작 시 미리 만들기(게임 스레드에서 동기 로딩하지 않도록 클래스를 비동기로 불러온 뒤)
+	TArray<FSoftObjectPath> ClassPaths;
+	for(const FVRActorPoolConfig& Config : PrewarmClasses)
+	{
+		if(Config.ActorClass.IsNull() == false)
+		{
+			ClassPaths.AddUnique(Config.ActorClass.ToSoftObjectPath());
+		}
+	}
+
+	if(ClassPaths.Num() > 0)
+	{
+		PrewarmLoadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(ClassPaths,
+			FStreamableDelegate::CreateUObject(this, &UVRActorPoolSubsystem::OnPrewarmClassesLoaded));
+	}
+}
+
+void UVRActorPoolSubsystem::OnPrewarmClassesLoaded()
+{
+	for(const FVRActorPoolConfig& Config : PrewarmClasses)
+	{
+		if(UClass* ActorClass = Config.ActorClass.Get())
+		{
+			Prewarm(ActorClass, Config.PrewarmCount, Config.MaxCount);
+		}
+	}
+}
+
+void UVRActorPoolSubsystem::Deinitialize()
+{
+	if(PrewarmLoadHandle.IsValid())
+	{
+		PrewarmLoadHandle->CancelHandle();
+		PrewarmLoadHandle.Reset();
+	}
+	Pools.Empty();
+	ActiveActors.Empty();
+	ActiveSerials.Empty();
+
+	Super::Deinitialize();
+}
+
+void UVRActorPoolSubsystem::Prewarm(UClass* ActorClass, int32 Count, int32 MaxCount)
+{
+	if(ActorClass == nullptr)
+	{
+		return;
+	}
+
+	FVRActorPool& Pool = Pools.FindOrAdd(ActorClass);
+	if(MaxCount > 0)
+	{
+		Pool.MaxCount = MaxCount;
+	}
+
+	while(Pool.FreeActors.Num() < Count && (Pool.MaxCount == 0 || Pool.TotalCount < Pool.MaxCount))
+	{
+		AActor* Actor = SpawnPooledActor(ActorClass, FTransform::Identity);
+		if(Actor == nullptr)
+		{
+			break;
+		}
+		DeactivateActor(Actor);
+		Pool.FreeActors.Add(Actor);
+	}
+}
+
+AActor* UVRActorPoolSubsystem::SpawnPooledActor(UClass* ActorClass, const FTransform& Transform)
+{
+	FActorSpawnParameters Params;
+	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	AActor* Actor = GetWorld()->SpawnActor<AActor>(ActorClass, Transform, Params);
+	if(Actor)
+	{
+		Pools.FindOrAdd(ActorClass).TotalCount++;
+		NumSpawned++;
+		CSV_CUSTOM_STAT(VRProject, PoolSpawned, 1, ECsvCustomStatOp::Accumulate);
+	}
+	return Actor;
+}
+
+AActor* UVRActorPoolSubsystem::Acquire(UClass* ActorClass, const FTransform& Transform)
+{
+	if(ActorClass == nullptr)
+	{
+		return nullptr;
+	}
+
+	// 비교용으로 풀을 끄면 매번 새로 만든다(추적하지 않으므로 Release에서 파괴된다).
+	if(CVarActorPoolEnabled.GetValueOnGameThread() == 0)
+	{
+		FActorSpawnParameters Params;
+		Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		AActor* Actor = GetWorld()->SpawnActor<AActor>(ActorClass, Transform, Params);
+		if(Actor)
+		{
+			NumSpawned++;
+			CSV_CUSTOM_STAT(VRProject, PoolSpawned, 1, ECsvCustomStatOp::Accumulate);
+			ActivateActor(Actor, Transform);
+		}
+		return Actor;
+	}
+
+	FVRActorPool& Pool = Pools.FindOrAdd(ActorClass);
+
+	// 1. 쉬고 있는 액터 재사용(밖에서 파괴된 액터는 건너뛴다)
+	AActor* Actor = nullptr;
+	while(Pool.FreeActors.Num() > 0 && Actor == nullptr)
+	{
+		Actor = Pool.FreeActors.Pop(false);
+		if(IsValid(Actor) == false)
+		{
+			Actor = nullptr;
+			Pool.TotalCount--;
+		}
+	}
+
+	if(Actor)
+	{
+		NumReused++;
+		CSV_CUSTOM_STAT(VRProject, PoolReused, 1, ECsvCustomStatOp::Accumulate);
+	}
+	// 2. 없으면 최대 개수 안에서 새로 만든다.
+	else if(Pool.MaxCount == 0 || Pool.TotalCount < Pool.MaxCount)
+	{
+		Actor = SpawnPooledActor(ActorClass, Transform);
+	}
+
+	if(Actor == nullptr)
+	{
+		UE_LOG(LogVRProject, Verbose, TEXT("Actor pool for %s is full (%d)"), *ActorClass->GetName(), Pool.MaxCount);
+		return nullptr;
+	}
+
+	ActiveActors.Add(Actor, ActorClass);
+	ActiveSerials.Add(Actor, ++LastSerial);
+	ActivateActor(Actor, Transform);
+	SET_DWORD_STAT(STAT_VRPoolActive, ActiveActors.Num());
+	return Actor;
+}
+
+AActor* UVRActorPoolSubsystem::AcquireForDuration(UClass* ActorClass, const FTransform& Transform, float Duration)
+{
+	AActor* Actor = Acquire(ActorClass, Transform);
+	if(Actor)
+	{
+		// 그 사이 돌려놓고 다시 꺼낸 액터는 건드리지 않도록 꺼낸 번호를 기억한다.
+		FTimerHandle Handle;
+		TWeakObjectPtr<AActor> WeakActor = Actor;
+		const uint32 Serial = ActiveSerials.FindRef(Actor);
+		GetWorld()->GetTimerManager().SetTimer(Handle, FTimerDelegate::CreateWeakLambda(this, [this, WeakActor, Serial]()
+		{
+			if(WeakActor.IsValid() && ActiveSerials.FindRef(WeakActor.Get()) == Serial)
+			{
+				Release(WeakActor.Get());
+			}
+		}), Duration, false);
+	}
+	return Actor;
+}
+
+void UVRActorPoolSubsystem::Release(AActor* Actor)
+{
+	if(IsValid(Actor) == false)
+	{
+		return;
+	}
+
+	UClass* ActorClass = nullptr;
+	if(ActiveActors.RemoveAndCopyValue(Actor, ActorClass) == false)
+	{
+		// 1. 이미 돌려놓은 풀 액터를 또 돌려놓으면 아무것도 하지 않는다.
+		const FVRActorPool* Pool = Pools.Find(Actor->GetClass());
+		if(Pool && Pool->FreeActors.Contains(Actor))
+		{
+			ensureMsgf(false, TEXT("%s was released to the actor pool twice"), *Actor->GetName());
+			return;
+		}
+		// 2. 풀이 만든 적 없는 액터만 파괴
+		Actor->Destroy();
+		return;
+	}
+	ActiveSerials.Remove(Actor);
+
+	DeactivateActor(Actor);
+	Pools.FindOrAdd(ActorClass).FreeActors.Add(Actor);
+	SET_DWORD_STAT(STAT_VRPoolActive, ActiveActors.Num());
+}
+
+void UVRActorPoolSubsystem::ActivateActor(AActor* Actor, const FTransform& Transform)
+{
+	Actor->SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+	Actor->SetActorHiddenInGame(false);
+	Actor->SetActorEnableCollision(true);
+	Actor->SetActorTickEnabled(Actor->PrimaryActorTick.bStartWithTickEnabled);
+
+	if(Actor->Implements<UVRPoolableActor>())
+	{
+		IVRPoolableActor::Execute_OnAcquiredFromPool(Actor);
+	}
+}
+
+void UVRActorPoolSubsystem::DeactivateActor(AActor* Actor)
+{
+	if(Actor->Implements<UVRPoolableActor>())
+	{
+		IVRPoolableActor::Execute_OnReleasedToPool(Actor);
+	}
+
+	Actor->SetActorHiddenInGame(true);
+	Actor->SetActorEnableCollision(false);
+	Actor->SetActorTickEnabled(false);
+}
+
+// 풀 사용/미사용 비교: 꺼내기/돌려놓기 처리량과 GC 시간
+static FAutoConsoleCommandWithWorldAndArgs GVRActorPoolBenchmarkCmd(
+	TEXT("vr.ActorPool.Benchmark"),
+	TEXT("Compares pooled and unpooled spawn/despawn. Usage: vr.ActorPool.Benchmark <ClassPath> [Iterations] [BatchSize]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		auto ActorPool = World ? World->GetSubsystem<UVRActorPoolSubsystem>() : nullptr;
+		UClass* ActorClass = Args.Num() > 0 ? LoadClass<AActor>(nullptr, *Args[0]) : AActor::StaticClass();
+		if(ActorPool == nullptr || ActorClass == nullptr)
+		{
+			return;
+		}
+
+		const int32 Iterations = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 100;
+		const int32 BatchSize = Args.Num() > 2 ? FCString::Atoi(*Args[2]) : 32;
+		TArray<AActor*> Batch;
+
+		// 1. 풀 미사용
+		double Start = FPlatformTime::Seconds();
+		for(int32 i = 0; i < Iterations; i++)
+		{
+			for(int32 j = 0; j < BatchSize; j++)
+			{
+				Batch.Add(World->SpawnActor<AActor>(ActorClass, FTransform::Identity));
+			}
+			for(AActor* Actor : Batch)
+			{
+				if(Actor)
+				{
+					Actor->Destroy();
+				}
+			}
+			Batch.Reset();
+		}
+		const double UnpooledSeconds = FPlatformTime::Seconds() - Start;
+		Start = FPlatformTime::Seconds();
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+		const double UnpooledGCSeconds = FPlatformTime::Seconds() - Start;
+
+		// 2. 풀 사용
+		ActorPool->Prewarm(ActorClass, BatchSize);
+		Start = FPlatformTime::Seconds();
+		for(int32 i = 0; i < Iterations; i++)
+		{
+			for(int32 j = 0; j < BatchSize; j++)
+			{
+				Batch.Add(ActorPool->Acquire(ActorClass, FTransform::Identity));
+			}
+			for(AActor* Actor : Batch)
+			{
+				ActorPool->Release(Actor);
+			}
+			Batch.Reset();
+		}
+		const double PooledSeconds = FPlatformTime::Seconds() - Start;
+		Start = FPlatformTime::Seconds();
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+		const double PooledGCSeconds = FPlatformTime::Seconds() - Start;
+
+		const int32 Total = Iterations * BatchSize;
+		UE_LOG(LogVRProject, Display, TEXT("%s x%d unpooled: %.1f actors/ms, GC %.2f ms"), *ActorClass->GetName(), Total, Total / FMath::Max(UnpooledSeconds * 1000.0, 0.001), UnpooledGCSeconds * 1000.0);
+		UE_LOG(LogVRProject, Display, TEXT("%s x%d pooled:   %.1f actors/ms, GC %.2f ms"), *ActorClass->GetName(), Total, Total / FMath::Max(PooledSeconds * 1000.0, 0.001), PooledGCSeconds * 1000.0);
+	}));
+
+// 풀 사용/미사용 세션 비교: 총 쏘는 봇을 띄워 정해진 시간 동안 CSV 프로파일을 남긴다.
+// 예) 서버(-nullrhi)에서 vr.ActorPool.Session 10 64 1 -> 끝난 뒤 vr.ActorPool.Session 10 64 0
+// -> 두 CSV의 FrameTime, VRProject/GCMs, VRProject/PoolSpawned, VRProject/PoolReused를 비교한다.
+static FAutoConsoleCommandWithWorldAndArgs GVRActorPoolSessionCmd(
+	TEXT("vr.ActorPool.Session"),
+	TEXT("Runs a scripted bot fire session under the CSV profiler with pooling on or off. Usage: vr.ActorPool.Session [Minutes] [Bots] [Pooled]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		auto ActorPool = World ? World->GetSubsystem<UVRActorPoolSubsystem>() : nullptr;
+		if(ActorPool == nullptr || World->GetAuthGameMode() == nullptr)
+		{
+			UE_LOG(LogVRProject, Warning, TEXT("vr.ActorPool.Session must run on the server"));
+			return;
+		}
+
+		const float Minutes = Args.Num() > 0 ? FCString::Atof(*Args[0]) : 10.f;
+		const int32 BotCount = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 64;
+		const bool bPooled = Args.Num() > 2 ? FCString::Atoi(*Args[2]) != 0 : true;
+
+		// 1. 풀 설정, 봇, 측정 시작
+		CVarActorPoolEnabled->Set(bPooled ? 1 : 0, ECVF_SetByConsole);
+		GEngine->Exec(World, *FString::Printf(TEXT("vr.Bots.Spawn %d Shooter"), BotCount));
+		GEngine->Exec(World, TEXT("vr.Session.ResetStats"));
+		GEngine->Exec(World, TEXT("csvprofile start"));
+
+		const int32 StartSpawned = ActorPool->GetNumSpawned();
+		const int32 StartReused = ActorPool->GetNumReused();
+		UE_LOG(LogVRProject, Display, TEXT("Actor pool session started: %.1f min, %d shooter bots, pooling %s"), Minutes, BotCount, bPooled ? TEXT("on") : TEXT("off"));
+
+		// 2. 끝나면 측정을 멈추고 결과를 남긴 뒤 봇을 정리한다.
+		FTimerHandle Handle;
+		World->GetTimerManager().SetTimer(Handle, FTimerDelegate::CreateWeakLambda(ActorPool, [ActorPool, World, StartSpawned, StartReused, bPooled]()
+		{
+			GEngine->Exec(World, TEXT("csvprofile stop"));
+			GEngine->Exec(World, TEXT("vr.Session.Report"));
+			UE_LOG(LogVRProject, Display, TEXT("Actor pool session (pooling %s): spawned=%d reused=%d"),
+				bPooled ? TEXT("on") : TEXT("off"), ActorPool->GetNumSpawned() - StartSpawned, ActorPool->GetNumReused() - StartReused);
+			GEngine->Exec(World, TEXT("vr.Bots.Clear"));
+		}), FMath::Max(Minutes * 60.f, 1.f), false);
+	}));
@@ -0,0 +1,425 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "VRAimQuerySubsystem.h"
+#include "VRPlayer.h"
+#include "VRProject.h"
+#include "Async/ParallelFor.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/Level.h"
+#include "EngineUtils.h"
+#include "GameFramework/PlayerController.h"
+
+DECLARE_CYCLE_STAT(TEXT("Aim Query Batch"), STAT_VR_AimQueryBatch, STATGROUP_VRProject);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Aim Queries Batched"), STAT_VRAimQueriesBatched, STATGROUP_VRProject);
+
+static TAutoConsoleVariable<int32> CVarAimQueryBatch(
+	TEXT("vr.AimQuery.Batch"),
+	1,
+	TEXT("1: VR pawns submit per-frame aim traces to the batched aim query subsystem when the world issued at least vr.AimQuery.MinParallel aim queries last frame. 0: each pawn always traces synchronously in its own Tick."));
+
+static TAutoConsoleVariable<int32> CVarAimQueryMinParallel(
+	TEXT("vr.AimQuery.MinParallel"),
+	8,
+	TEXT("Minimum aim queries per frame (across all locally controlled pawns, including server bots) before pawns batch their queries and the batch runs in parallel."));
+
+void FVRAimQueryTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if(Owner)
+	{
+		Owner->TickBatch();
+	}
+}
+
+FString FVRAimQueryTickFunction::DiagnosticMessage()
+{
+	return TEXT("FVRAimQueryTickFunction");
+}
+
+bool UVRAimQuerySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool UVRAimQuerySubsystem::ShouldBatch() const
+{
+	return CVarAimQueryBatch.GetValueOnGameThread() != 0 && LastFrameQueries >= CVarAimQueryMinParallel.GetValueOnGameThread();
+}
+
+void UVRAimQuerySubsystem::TickBatch()
+{
+	// 묶을지는 지난 프레임 전체 질의 수로 정한다(이번 프레임 결과로 정하면 켜졌다 꺼졌다 한다).
+	LastFrameQueries = FrameQueries;
+	FrameQueries = 0;
+
+	ExecuteBatch();
+}
+
+void UVRAimQuerySubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// 폰 Tick(PrePhysics)에서 모은 질의를 물리 중에 실행해서 PostPhysics 전에 결과를 돌려준다.
+	TickFunction.Owner = this;
+	TickFunction.bCanEverTick = true;
+	TickFunction.bStartWithTickEnabled = true;
+	TickFunction.TickGroup = TG_DuringPhysics;
+	TickFunction.EndTickGroup = TG_DuringPhysics;
+	TickFunction.RegisterTickFunction(InWorld.PersistentLevel);
+
+	// 텔레포트 채널은 기본 무시이므로 옛 맵의 바닥에 TeleportFloor 프로필을 입힌다.
+	TArray<AActor*> Actors;
+	for(TActorIterator<AActor> It(&InWorld); It; ++It)
+	{
+		Actors.Add(*It);
+	}
+	ApplyLegacyTeleportFloors(Actors);
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UVRAimQuerySubsystem::OnLevelAdded);
+}
+
+void UVRAimQuerySubsystem::ApplyLegacyTeleportFloors(const TArray<AActor*>& Actors)
+{
+	if(LegacyTeleportFloorNames.Num() == 0)
+	{
+		return;
+	}
+
+	int32 NumApplied = 0;
+	for(AActor* Actor : Actors)
+	{
+		if(Actor == nullptr || LegacyTeleportFloorNames.ContainsByPredicate([Actor](const FString& Name) { return Actor->GetName().Contains(Name); }) == false)
+		{
+			continue;
+		}
+
+		TInlineComponentArray<UPrimitiveComponent*> Components(Actor);
+		for(UPrimitiveComponent* Component : Components)
+		{
+			if(Component->IsCollisionEnabled())
+			{
+				Component->SetCollisionProfileName(VR_PROFILE_TeleportFloor);
+				NumApplied++;
+			}
+		}
+	}
+
+	if(NumApplied > 0)
+	{
+		UE_LOG(LogVRProject, Log, TEXT("Applied the %s collision profile to %d legacy floor components (resave them with the profile and clear LegacyTeleportFloorNames)"), VR_PROFILE_TeleportFloor, NumApplied);
+	}
+}
+
+void UVRAimQuerySubsystem::OnLevelAdded(ULevel* Level, UWorld* World)
+{
+	if(Level && World == GetWorld())
+	{
+		ApplyLegacyTeleportFloors(Level->Actors);
+	}
+}
+
+void UVRAimQuerySubsystem::Deinitialize()
+{
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+
+	if(TickFunction.IsTickFunctionRegistered())
+	{
+		TickFunction.UnRegisterTickFunction();
+	}
+	TickFunction.Owner = nullptr;
+	ResetBatch();
+
+	Super::Deinitialize();
+}
+
+void UVRAimQuerySubsystem::Submit(AVRPlayer* Requester, EVRAimQuery Kind, TArrayView<const FVector> InPoints, float Radius, ECollisionChannel Channel)
+{
+	if(InPoints.Num() < 2)
+	{
+		return;
+	}
+
+	FrameQueries++;
+	Requesters.Add(Requester);
+	Kinds.Add(Kind);
+	PointOffsets.Add(Points.Num());
+	PointCounts.Add(InPoints.Num());
+	Points.Append(InPoints.GetData(), InPoints.Num());
+	Radii.Add(Radius);
+	Channels.Add(Channel);
+}
+
+void UVRAimQuerySubsystem::RunQuery(int32 Index)
+{
+	const AVRPlayer* Requester = Requesters[Index].Get();
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(VRAimQuery), false, Requester);
+
+	const FVector* QueryPoints = &Points[PointOffsets[Index]];
+	FHitResult& Hit = Hits[Index];
+	HitSegments[Index] = INDEX_NONE;
+
+	// 선분을 순서대로 검사해서 처음 닿는 곳에서 멈춘다.
+	for(int32 Segment = 0; Segment < PointCounts[Index] - 1; Segment++)
+	{
+		bool bHit;
+		if(Radii[Index] > 0.f)
+		{
+			bHit = GetWorld()->SweepSingleByChannel(Hit, QueryPoints[Segment], QueryPoints[Segment + 1], FQuat::Identity, Channels[Index], FCollisionShape::MakeSphere(Radii[Index]), Params);
+		}
+		else
+		{
+			bHit = GetWorld()->LineTraceSingleByChannel(Hit, QueryPoints[Segment], QueryPoints[Segment + 1], Channels[Index], Params);
+		}
+
+		if(bHit)
+		{
+			HitSegments[Index] = Segment;
+			return;
+		}
+	}
+}
+
+void UVRAimQuerySubsystem::ExecuteBatch(bool bParallel)
+{
+	const int32 Num = Kinds.Num();
+	if(Num == 0)
+	{
+		return;
+	}
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_VR_AimQueryBatch);
+		CSV_SCOPED_TIMING_STAT(VRProject, AimQueryBatch);
+
+		Hits.SetNum(Num);
+		HitSegments.SetNum(Num);
+
+		// 물리 씬은 읽기만 하므로 질의끼리 나눠서 실행할 수 있다.
+		const bool bSingleThread = bParallel == false || Num < CVarAimQueryMinParallel.GetValueOnGameThread();
+		ParallelFor(Num, [this](int32 Index)
+		{
+			RunQuery(Index);
+		}, bSingleThread ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+	}
+
+	SET_DWORD_STAT(STAT_VRAimQueriesBatched, Num);
+	CSV_CUSTOM_STAT(VRProject, SceneQueries, Num, ECsvCustomStatOp::Accumulate);
+
+	// 결과를 게임 스레드에서 폰에 돌려준다.
+	for(int32 Index = 0; Index < Num; Index++)
+	{
+		if(AVRPlayer* Requester = Requesters[Index].Get())
+		{
+			const int32 Offset = PointOffsets[Index];
+			Requester->OnAimQueryResult(Kinds[Index], HitSegments[Index], Hits[Index], TArrayView<const FVector>(&Points[Offset], PointCounts[Index]));
+		}
+	}
+
+	ResetBatch();
+}
+
+void UVRAimQuerySubsystem::ResetBatch()
+{
+	// 할당은 유지해서 다음 프레임에 재사용한다.
+	Requesters.Reset();
+	Kinds.Reset();
+	PointOffsets.Reset();
+	PointCounts.Reset();
+	Points.Reset();
+	Radii.Reset();
+	Channels.Reset();
+}
+
+// 묶음/개별 질의 처리량 비교
+// 폰 1명당 크로스헤어 직선 1개, 원거리 잡기 구 쓸기 1개, 텔레포트 곡선 1개(40점)를 만든다.
+static FAutoConsoleCommandWithWorldAndArgs GVRAimQueryBenchmarkCmd(
+	TEXT("vr.AimQuery.Benchmark"),
+	TEXT("Compares synchronous and batched parallel aim queries for simulated pawns. Usage: vr.AimQuery.Benchmark [Iterations] [PawnCounts...] (default 16 64 256)"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		auto AimQuery = World ? World->GetSubsystem<UVRAimQuerySubsystem>() : nullptr;
+		if(AimQuery == nullptr)
+		{
+			return;
+		}
+
+		const int32 Iterations = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 20;
+		TArray<int32> PawnCounts;
+		for(int32 i = 1; i < Args.Num(); i++)
+		{
+			PawnCounts.Add(FMath::Max(1, FCString::Atoi(*Args[i])));
+		}
+		if(PawnCounts.Num() == 0)
+		{
+			PawnCounts = { 16, 64, 256 };
+		}
+
+		FVector Origin = FVector::ZeroVector;
+		if(APlayerController* PC = World->GetFirstPlayerController())
+		{
+			if(PC->GetPawn())
+			{
+				Origin = PC->GetPawn()->GetActorLocation();
+			}
+		}
+
+		for(int32 PawnCount : PawnCounts)
+		{
+			// 임의의 조준(고정 시드)
+			FRandomStream Random(PawnCount);
+			TArray<TArray<FVector>> Rays, Sweeps, Arcs;
+			for(int32 i = 0; i < PawnCount; i++)
+			{
+				const FVector Start = Origin + FVector(Random.FRandRange(-2000.f, 2000.f), Random.FRandRange(-2000.f, 2000.f), Random.FRandRange(50.f, 200.f));
+				const FVector Direction = Random.GetUnitVector();
+				Rays.Add({ Start, Start + Direction * 10000.f });
+				Sweeps.Add({ Start, Start + Direction * 2000.f });
+
+				TArray<FVector> Arc;
+				FVector Position = Start;
+				FVector Velocity = FVector(Direction.X, Direction.Y, FMath::Abs(Direction.Z)) * 1500.f;
+				Arc.Add(Position);
+				for(int32 Step = 1; Step < 40; Step++)
+				{
+					Velocity.Z += -5000.f * 0.02f;
+					Position += Velocity * 0.02f;
+					Arc.Add(Position);
+				}
+				Arcs.Add(MoveTemp(Arc));
+			}
+
+			auto SubmitAll = [&]()
+			{
+				for(int32 i = 0; i < PawnCount; i++)
+				{
+					AimQuery->Submit(nullptr, EVRAimQuery::Crosshair, Rays[i], 0.f, ECC_Hitscan);
+					AimQuery->Submit(nullptr, EVRAimQuery::RemoteGrabPreview, Sweeps[i], 20.f, ECC_Grabbable);
+					AimQuery->Submit(nullptr, EVRAimQuery::TeleportArc, Arcs[i], 0.f, ECC_Teleport);
+				}
+			};
+
+			// 1. 폰마다 게임 스레드에서 바로 실행(기존 방식과 같은 질의)
+			double Start = FPlatformTime::Seconds();
+			for(int32 It = 0; It < Iterations; It++)
+			{
+				SubmitAll();
+				AimQuery->ExecuteBatch(false);
+			}
+			const double SyncSeconds = FPlatformTime::Seconds() - Start;
+
+			// 2. 묶어서 ParallelFor로 실행
+			Start = FPlatformTime::Seconds();
+			for(int32 It = 0; It < Iterations; It++)
+			{
+				SubmitAll();
+				AimQuery->ExecuteBatch(true);
+			}
+			const double BatchSeconds = FPlatformTime::Seconds() - Start;
+
+			const double Queries = double(PawnCount) * 3 * Iterations;
+			UE_LOG(LogVRProject, Display, TEXT("Aim queries %4d pawns: synchronous %.1f queries/ms, batched %.1f queries/ms (%.2fx)"),
+				PawnCount, Queries / FMath::Max(SyncSeconds * 1000.0, 1e-6), Queries / FMath::Max(BatchSeconds * 1000.0, 1e-6), SyncSeconds / FMath::Max(BatchSeconds, 1e-9));
+		}
+	}));
+
+// 채널 전/후 비교: 같은 질의를 예전 채널(Visibility)과 전용 채널로 실행해서 질의당 시간과 맞은 수를 비교한다.
+// 예) -ExecCmds="vr.AimQuery.ChannelBenchmark 50 256" 후 로그, 또는 stat collision 과 함께 실행
+static FAutoConsoleCommandWithWorldAndArgs GVRAimQueryChannelBenchmarkCmd(
+	TEXT("vr.AimQuery.ChannelBenchmark"),
+	TEXT("Times the same teleport arcs, hitscan rays and grab sweeps on ECC_Visibility and on the dedicated channels. Usage: vr.AimQuery.ChannelBenchmark [Iterations] [Queries]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if(World == nullptr)
+		{
+			return;
+		}
+
+		const int32 Iterations = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 50;
+		const int32 NumQueries = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 256;
+
+		FVector Origin = FVector::ZeroVector;
+		const AActor* IgnoredActor = nullptr;
+		if(APlayerController* PC = World->GetFirstPlayerController())
+		{
+			if(PC->GetPawn())
+			{
+				Origin = PC->GetPawn()->GetActorLocation();
+				IgnoredActor = PC->GetPawn();
+			}
+		}
+
+		// 임의의 조준(고정 시드)
+		FRandomStream Random(NumQueries);
+		TArray<FVector> Starts, Directions;
+		for(int32 i = 0; i < NumQueries; i++)
+		{
+			Starts.Add(Origin + FVector(Random.FRandRange(-2000.f, 2000.f), Random.FRandRange(-2000.f, 2000.f), Random.FRandRange(50.f, 200.f)));
+			Directions.Add(Random.GetUnitVector());
+		}
+
+		FCollisionQueryParams Params(SCENE_QUERY_STAT(VRChannelBenchmark), false, IgnoredActor);
+		auto Run = [&](ECollisionChannel Channel, float Radius, float Length, bool bArc, int32& OutHits)
+		{
+			OutHits = 0;
+			int32 NumTraces = 0;
+			const double Start = FPlatformTime::Seconds();
+			for(int32 It = 0; It < Iterations; It++)
+			{
+				for(int32 i = 0; i < NumQueries; i++)
+				{
+					FHitResult Hit;
+					// 텔레포트 곡선은 40개 선분을 처음 닿을 때까지 검사한다.
+					FVector Position = Starts[i];
+					FVector Velocity = FVector(Directions[i].X, Directions[i].Y, FMath::Abs(Directions[i].Z)) * 1500.f;
+					const int32 Segments = bArc ? 39 : 1;
+					for(int32 Segment = 0; Segment < Segments; Segment++)
+					{
+						FVector Next;
+						if(bArc)
+						{
+							Velocity.Z += -5000.f * 0.02f;
+							Next = Position + Velocity * 0.02f;
+						}
+						else
+						{
+							Next = Position + Directions[i] * Length;
+						}
+
+						NumTraces++;
+						const bool bHit = Radius > 0.f
+							? World->SweepSingleByChannel(Hit, Position, Next, FQuat::Identity, Channel, FCollisionShape::MakeSphere(Radius), Params)
+							: World->LineTraceSingleByChannel(Hit, Position, Next, Channel, Params);
+						if(bHit)
+						{
+							OutHits += It == 0 ? 1 : 0;
+							break;
+						}
+						Position = Next;
+					}
+				}
+			}
+			return (FPlatformTime::Seconds() - Start) * 1e6 / FMath::Max(NumTraces, 1);
+		};
+
+		struct FCase
+		{
+			const TCHAR* Name;
+			ECollisionChannel Channel;
+			float Radius;
+			float Length;
+			bool bArc;
+		};
+		const FCase Cases[] =
+		{
+			{ TEXT("Teleport arc"), ECC_Teleport, 0.f, 0.f, true },
+			{ TEXT("Hitscan ray"), ECC_Hitscan, 0.f, 10000.f, false },
+			{ TEXT("Grab sweep"), ECC_Grabbable, 20.f, 2000.f, false },
+		};
+		for(const FCase& Case : Cases)
+		{
+			int32 BeforeHits, AfterHits;
+			const double BeforeUs = Run(ECC_Visibility, Case.Radius, Case.Length, Case.bArc, BeforeHits);
+			const double AfterUs = Run(Case.Channel, Case.Radius, Case.Length, Case.bArc, AfterHits);
+			UE_LOG(LogVRProject, Display, TEXT("%-12s Visibility %.2f us/trace (%d hits), dedicated channel %.2f us/trace (%d hits), %.2fx"),
+				Case.Name, BeforeUs, BeforeHits, AfterUs, AfterHits, BeforeUs / FMath::Max(AfterUs, 1e-6));
+		}
+	}));
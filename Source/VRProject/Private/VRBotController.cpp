@@ -0,0 +1,257 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "VRBotController.h"
+#include "VRPlayer.h"
+#include "VRProject.h"
+#include "InputAction.h"
+#include "EngineUtils.h"
+#include "GameFramework/GameModeBase.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+AVRBotController::AVRBotController()
+{
+	PrimaryActorTick.bCanEverTick = true;
+	// 폰보다 먼저 입력을 넣어준다.
+	PrimaryActorTick.TickGroup = TG_PrePhysics;
+}
+
+void AVRBotController::SetRandomSeed(int32 Seed)
+{
+	Random.Initialize(Seed);
+	MotionPhase = Random.FRandRange(0.f, 2.f * PI);
+	NextActionTime = ElapsedTime + Random.FRandRange(0.f, ActionInterval);
+}
+
+void AVRBotController::OnPossess(APawn* InPawn)
+{
+	Super::OnPossess(InPawn);
+
+	VRPawn = Cast<AVRPlayer>(InPawn);
+}
+
+void AVRBotController::OnUnPossess()
+{
+	// 눌려있던 버튼은 떼고 나간다.
+	if(VRPawn)
+	{
+		if(bTeleportHeld)
+		{
+			VRPawn->InjectInputAction(VRPawn->IA_Teleport.Get(), ETriggerEvent::Completed, FInputActionValue(true));
+		}
+		if(bGrabHeld)
+		{
+			VRPawn->InjectInputAction(VRPawn->IA_Grab.Get(), ETriggerEvent::Completed, FInputActionValue(true));
+		}
+	}
+	bTeleportHeld = false;
+	bGrabHeld = false;
+	VRPawn = nullptr;
+
+	Super::OnUnPossess();
+}
+
+void AVRBotController::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if(VRPawn == nullptr)
+	{
+		return;
+	}
+
+	CSV_CUSTOM_STAT(VRProject, BotCount, 1, ECsvCustomStatOp::Accumulate);
+
+	ElapsedTime += DeltaTime;
+
+	UpdateTrackingPose();
+	UpdateHeldInputs();
+
+	if(ElapsedTime >= NextActionTime)
+	{
+		DoNextAction();
+		// 평균 ActionInterval 간격으로 다음 행동
+		NextActionTime = ElapsedTime + Random.FRandRange(0.5f, 1.5f) * ActionInterval;
+	}
+}
+
+void AVRBotController::UpdateTrackingPose()
+{
+	const float T = ElapsedTime + MotionPhase;
+
+	// 머리: 천천히 둘러보며 살짝 흔들린다.
+	FTransform Head;
+	Head.SetLocation(FVector(0.f, 0.f, 60.f) + FVector(FMath::Sin(T * 0.7f), FMath::Sin(T * 0.9f), FMath::Sin(T * 1.3f) * 0.5f) * HeadMotionAmplitude);
+	Head.SetRotation(FRotator(FMath::Sin(T * 0.5f) * 15.f, FMath::Sin(T * 0.3f) * 60.f, 0.f).Quaternion());
+
+	// 손: 몸 앞에서 8자 모양으로 흔든다.
+	FTransform Left;
+	Left.SetLocation(FVector(30.f, -20.f, 20.f) + FVector(FMath::Sin(T * 1.1f), FMath::Sin(T * 2.2f) * 0.5f, FMath::Cos(T * 1.1f)) * HandMotionAmplitude);
+	Left.SetRotation(FRotator(FMath::Sin(T) * 20.f, FMath::Cos(T * 0.8f) * 30.f, 0.f).Quaternion());
+
+	FTransform Right;
+	Right.SetLocation(FVector(30.f, 20.f, 20.f) + FVector(FMath::Cos(T * 1.2f), FMath::Sin(T * 2.4f) * 0.5f, FMath::Sin(T * 1.2f)) * HandMotionAmplitude);
+	Right.SetRotation(FRotator(FMath::Sin(T * 0.9f) * 30.f - 10.f, FMath::Sin(T * 0.4f) * 45.f, 0.f).Quaternion());
+
+	VRPawn->SetTrackingPose(Head, Left, Right);
+}
+
+void AVRBotController::UpdateHeldInputs()
+{
+	// 이동 입력은 유지되는 동안 매 프레임 Triggered
+	if(ElapsedTime < MoveEndTime)
+	{
+		VRPawn->InjectInputAction(VRPawn->IA_VRMove.Get(), ETriggerEvent::Triggered, FInputActionValue(MoveAxis));
+	}
+
+	if(bTeleportHeld && ElapsedTime >= TeleportReleaseTime)
+	{
+		VRPawn->InjectInputAction(VRPawn->IA_Teleport.Get(), ETriggerEvent::Completed, FInputActionValue(true));
+		bTeleportHeld = false;
+	}
+
+	if(bGrabHeld && ElapsedTime >= GrabReleaseTime)
+	{
+		VRPawn->InjectInputAction(VRPawn->IA_Grab.Get(), ETriggerEvent::Completed, FInputActionValue(true));
+		bGrabHeld = false;
+	}
+}
+
+void AVRBotController::DoNextAction()
+{
+	// 행동별 가중치: 이동, 텔레포트, 잡기, 총쏘기
+	float Weights[4] = { 0.25f, 0.25f, 0.25f, 0.25f };
+	switch(Behavior)
+	{
+	case EVRBotBehavior::Wanderer:
+		Weights[0] = 0.7f; Weights[1] = 0.1f; Weights[2] = 0.1f; Weights[3] = 0.1f;
+		break;
+	case EVRBotBehavior::Teleporter:
+		Weights[0] = 0.1f; Weights[1] = 0.7f; Weights[2] = 0.1f; Weights[3] = 0.1f;
+		break;
+	case EVRBotBehavior::GrabSpammer:
+		Weights[0] = 0.1f; Weights[1] = 0.1f; Weights[2] = 0.7f; Weights[3] = 0.1f;
+		break;
+	case EVRBotBehavior::Shooter:
+		Weights[0] = 0.1f; Weights[1] = 0.1f; Weights[2] = 0.1f; Weights[3] = 0.7f;
+		break;
+	default:
+		break;
+	}
+
+	float Pick = Random.FRand();
+	int32 Action = 0;
+	for(; Action < 3; Action++)
+	{
+		Pick -= Weights[Action];
+		if(Pick <= 0.f)
+		{
+			break;
+		}
+	}
+
+	switch(Action)
+	{
+	case 0:
+		// 이동: 임의 방향으로 잠시 걷는다.
+		MoveAxis = FVector2D(Random.FRandRange(-1.f, 1.f), Random.FRandRange(-1.f, 1.f)).GetSafeNormal();
+		MoveEndTime = ElapsedTime + Random.FRandRange(0.5f, 2.f);
+		break;
+	case 1:
+		// 텔레포트: 누르고 잠시 조준한 뒤 뗀다.
+		if(bTeleportHeld == false)
+		{
+			VRPawn->InjectInputAction(VRPawn->IA_Teleport.Get(), ETriggerEvent::Started, FInputActionValue(true));
+			bTeleportHeld = true;
+			TeleportReleaseTime = ElapsedTime + Random.FRandRange(0.5f, 1.5f);
+		}
+		break;
+	case 2:
+		// 잡기: 잡고 흔들다가 놓는다.
+		if(bGrabHeld == false)
+		{
+			VRPawn->InjectInputAction(VRPawn->IA_Grab.Get(), ETriggerEvent::Started, FInputActionValue(true));
+			bGrabHeld = true;
+			GrabReleaseTime = ElapsedTime + Random.FRandRange(0.3f, 2.f);
+		}
+		break;
+	default:
+		// 총쏘기
+		VRPawn->InjectInputAction(VRPawn->IA_Fire.Get(), ETriggerEvent::Started, FInputActionValue(true));
+		break;
+	}
+}
+
+// 부하 테스트용 콘솔 명령
+// 예) 서버에서 -nullrhi -ExecCmds="vr.Bots.Spawn 200 Mixed, csvprofile start" 후 csvprofile stop
+// -> Saved/Profiling/CSV에 FrameTime, GameThreadTime, 물리 시간과 VRProject/BotCount, VRProject/SceneQueries 열이 기록된다.
+static FAutoConsoleCommandWithWorldAndArgs GVRBotsSpawnCmd(
+	TEXT("vr.Bots.Spawn"),
+	TEXT("Spawns N bot-driven VR pawns. Usage: vr.Bots.Spawn <Count> [Wanderer|Teleporter|GrabSpammer|Shooter|Mixed] [Spacing]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if(World == nullptr || World->GetAuthGameMode() == nullptr)
+		{
+			UE_LOG(LogVRProject, Warning, TEXT("vr.Bots.Spawn must run on the server"));
+			return;
+		}
+
+		const int32 Count = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 100;
+		EVRBotBehavior Behavior = EVRBotBehavior::Mixed;
+		if(Args.Num() > 1)
+		{
+			const int64 Value = StaticEnum<EVRBotBehavior>()->GetValueByNameString(Args[1]);
+			if(Value != INDEX_NONE)
+			{
+				Behavior = (EVRBotBehavior)Value;
+			}
+		}
+		const float Spacing = Args.Num() > 2 ? FCString::Atof(*Args[2]) : 300.f;
+
+		// 게임 모드의 기본 폰(블루프린트) 클래스를 사용한다.
+		UClass* PawnClass = AVRPlayer::StaticClass();
+		AGameModeBase* GameMode = World->GetAuthGameMode();
+		if(GameMode->DefaultPawnClass && GameMode->DefaultPawnClass->IsChildOf(AVRPlayer::StaticClass()))
+		{
+			PawnClass = GameMode->DefaultPawnClass;
+		}
+
+		FActorSpawnParameters Params;
+		Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+		const int32 Columns = FMath::Max(1, FMath::CeilToInt(FMath::Sqrt((float)Count)));
+		for(int32 i = 0; i < Count; i++)
+		{
+			const FVector Location((i / Columns) * Spacing, (i % Columns - Columns / 2) * Spacing, 200.f);
+			AVRPlayer* Pawn = World->SpawnActor<AVRPlayer>(PawnClass, Location, FRotator::ZeroRotator, Params);
+			AVRBotController* Bot = World->SpawnActor<AVRBotController>(Params);
+			if(Pawn && Bot)
+			{
+				Bot->Behavior = Behavior;
+				Bot->SetRandomSeed(i);
+				Bot->Possess(Pawn);
+			}
+		}
+
+		UE_LOG(LogVRProject, Display, TEXT("Spawned %d VR bots (%s)"), Count, *StaticEnum<EVRBotBehavior>()->GetNameStringByValue((int64)Behavior));
+	}));
+
+static FAutoConsoleCommandWithWorld GVRBotsClearCmd(
+	TEXT("vr.Bots.Clear"),
+	TEXT("Destroys all bot-driven VR pawns."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if(World == nullptr)
+		{
+			return;
+		}
+
+		for(TActorIterator<AVRBotController> It(World); It; ++It)
+		{
+			if(APawn* Pawn = It->GetPawn())
+			{
+				Pawn->Destroy();
+			}
+			It->Destroy();
+		}
+	}));
@@ -2,3 +2,390 @@
 
 
 #include "VRGameModeBase.h"
+#include "VRPlayer.h"
+#include "VRPlayerController.h"
+#include "VRBotController.h"
+#include "VRActorPoolSubsystem.h"
+#include "VRProject.h"
+#include "TimerManager.h"
+#include "GameFramework/GameStateBase.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectGlobals.h"
+
+AVRGameModeBase::AVRGameModeBase()
+{
+	PlayerControllerClass = AVRPlayerController::StaticClass();
+}
+
+void AVRGameModeBase::StartPlay()
+{
+	Super::StartPlay();
+
+	// 접속 전에 폰을 미리 만들어 둔다.
+	auto ActorPool = GetWorld()->GetSubsystem<UVRActorPoolSubsystem>();
+	if(ActorPool && DefaultPawnClass && DefaultPawnClass->IsChildOf(AVRPlayer::StaticClass()))
+	{
+		ActorPool->Prewarm(DefaultPawnClass, PawnPoolSize);
+	}
+
+	FCoreUObjectDelegates::GetPreGarbageCollectDelegate().AddUObject(this, &AVRGameModeBase::OnPreGarbageCollect);
+	FCoreUObjectDelegates::GetPostGarbageCollect().AddUObject(this, &AVRGameModeBase::OnPostGarbageCollect);
+}
+
+void AVRGameModeBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	FCoreUObjectDelegates::GetPreGarbageCollectDelegate().RemoveAll(this);
+	FCoreUObjectDelegates::GetPostGarbageCollect().RemoveAll(this);
+	GetWorldTimerManager().ClearTimer(ChurnTimer);
+	StopClientChurn();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AVRGameModeBase::PostLogin(APlayerController* NewPlayer)
+{
+	// 접속 처리(폰 준비와 빙의 포함) 시간
+	const double StartTime = FPlatformTime::Seconds();
+	Super::PostLogin(NewPlayer);
+	RecordJoin(FPlatformTime::Seconds() - StartTime);
+}
+
+void AVRGameModeBase::Logout(AController* Exiting)
+{
+	PlayerUsage.Remove(Exiting);
+
+	Super::Logout(Exiting);
+}
+
+APawn* AVRGameModeBase::SpawnDefaultPawnAtTransform_Implementation(AController* NewPlayer, const FTransform& SpawnTransform)
+{
+	// VR 폰은 풀에서 꺼낸다.
+	UClass* PawnClass = GetDefaultPawnClassForController(NewPlayer);
+	auto ActorPool = GetWorld()->GetSubsystem<UVRActorPoolSubsystem>();
+	if(ActorPool && PawnClass && PawnClass->IsChildOf(AVRPlayer::StaticClass()))
+	{
+		if(APawn* Pawn = ActorPool->Acquire<APawn>(PawnClass, SpawnTransform))
+		{
+			return Pawn;
+		}
+	}
+
+	return Super::SpawnDefaultPawnAtTransform_Implementation(NewPlayer, SpawnTransform);
+}
+
+void AVRGameModeBase::ReleasePlayerPawn(AController* Controller)
+{
+	APawn* Pawn = Controller ? Controller->GetPawn() : nullptr;
+	if(Pawn == nullptr)
+	{
+		return;
+	}
+
+	Controller->UnPossess();
+
+	// 풀에서 꺼낸 폰이 아니면 Release가 파괴한다.
+	if(auto ActorPool = GetWorld()->GetSubsystem<UVRActorPoolSubsystem>())
+	{
+		ActorPool->Release(Pawn);
+	}
+	else
+	{
+		Pawn->Destroy();
+	}
+}
+
+bool AVRGameModeBase::TryUseImpactMarker(AController* Controller, float Lifetime)
+{
+	if(Controller == nullptr)
+	{
+		return true;
+	}
+
+	FVRPlayerUsage& Usage = PlayerUsage.FindOrAdd(Controller);
+	const float Now = GetWorld()->GetTimeSeconds();
+	Usage.ImpactMarkerExpiry.RemoveAllSwap([Now](float Expiry)
+	{
+		return Expiry <= Now;
+	});
+
+	if(Usage.ImpactMarkerExpiry.Num() >= PlayerBudget.MaxImpactMarkers)
+	{
+		Usage.DeniedImpactMarkers++;
+		return false;
+	}
+	Usage.ImpactMarkerExpiry.Add(Now + Lifetime);
+	return true;
+}
+
+void AVRGameModeBase::RecordPawnTick(AController* Controller, double Seconds)
+{
+	if(Controller == nullptr)
+	{
+		return;
+	}
+
+	// 최근 값에 가중치를 둔 평균
+	FVRPlayerUsage& Usage = PlayerUsage.FindOrAdd(Controller);
+	Usage.TickMsAverage = FMath::Lerp(Usage.TickMsAverage, Seconds * 1000.0, 0.1);
+	if(Usage.TickMsAverage + Usage.MoveMsAverage > PlayerBudget.PawnTickBudgetMs)
+	{
+		Usage.OverBudgetTicks++;
+		CSV_CUSTOM_STAT(VRProject, PlayersOverTickBudget, 1, ECsvCustomStatOp::Accumulate);
+	}
+}
+
+void AVRGameModeBase::RecordPawnMovement(AController* Controller, double Seconds)
+{
+	if(Controller == nullptr)
+	{
+		return;
+	}
+
+	FVRPlayerUsage& Usage = PlayerUsage.FindOrAdd(Controller);
+	Usage.MoveMsAverage = FMath::Lerp(Usage.MoveMsAverage, Seconds * 1000.0, 0.1);
+}
+
+FVRPlayerBudget AVRGameModeBase::GetPlayerBudget(const UWorld* World)
+{
+	if(const AVRGameModeBase* GameMode = World ? World->GetAuthGameMode<AVRGameModeBase>() : nullptr)
+	{
+		return GameMode->PlayerBudget;
+	}
+
+	// 클라이언트에는 게임 모드가 없지만 게임 모드 클래스는 GameState로 복제된다(기본값 = 같은 Config).
+	const AGameStateBase* GameState = World ? World->GetGameState() : nullptr;
+	if(const AVRGameModeBase* DefaultGameMode = GameState ? GameState->GetDefaultGameMode<AVRGameModeBase>() : nullptr)
+	{
+		return DefaultGameMode->PlayerBudget;
+	}
+	return FVRPlayerBudget();
+}
+
+void AVRGameModeBase::RecordJoin(double Seconds)
+{
+	JoinCount++;
+	JoinTotalSeconds += Seconds;
+	JoinMaxSeconds = FMath::Max(JoinMaxSeconds, Seconds);
+	CSV_CUSTOM_STAT(VRProject, JoinMs, Seconds * 1000.0, ECsvCustomStatOp::Max);
+}
+
+void AVRGameModeBase::OnPreGarbageCollect()
+{
+	GCStartTime = FPlatformTime::Seconds();
+}
+
+void AVRGameModeBase::OnPostGarbageCollect()
+{
+	const double Seconds = FPlatformTime::Seconds() - GCStartTime;
+	GCCount++;
+	GCTotalSeconds += Seconds;
+	GCMaxSeconds = FMath::Max(GCMaxSeconds, Seconds);
+	CSV_CUSTOM_STAT(VRProject, GCMs, Seconds * 1000.0, ECsvCustomStatOp::Max);
+}
+
+void AVRGameModeBase::ReportSession()
+{
+	auto ActorPool = GetWorld()->GetSubsystem<UVRActorPoolSubsystem>();
+	UE_LOG(LogVRProject, Display, TEXT("Session joins=%d avg=%.2f ms max=%.2f ms, pooled actors spawned=%d reused=%d"),
+		JoinCount, JoinCount > 0 ? JoinTotalSeconds * 1000.0 / JoinCount : 0.0, JoinMaxSeconds * 1000.0,
+		ActorPool ? ActorPool->GetNumSpawned() : 0, ActorPool ? ActorPool->GetNumReused() : 0);
+	UE_LOG(LogVRProject, Display, TEXT("Session GC count=%d avg=%.2f ms max=%.2f ms"),
+		GCCount, GCCount > 0 ? GCTotalSeconds * 1000.0 / GCCount : 0.0, GCMaxSeconds * 1000.0);
+
+	for(const TPair<TWeakObjectPtr<AController>, FVRPlayerUsage>& Pair : PlayerUsage)
+	{
+		if(AController* Controller = Pair.Key.Get())
+		{
+			const FVRPlayerUsage& Usage = Pair.Value;
+			UE_LOG(LogVRProject, Display, TEXT("  %-24s tick=%.3f move=%.3f /%.3f ms overBudgetTicks=%d markers=%d/%d denied=%d"),
+				*Controller->GetName(), Usage.TickMsAverage, Usage.MoveMsAverage, PlayerBudget.PawnTickBudgetMs, Usage.OverBudgetTicks,
+				Usage.ImpactMarkerExpiry.Num(), PlayerBudget.MaxImpactMarkers, Usage.DeniedImpactMarkers);
+		}
+	}
+}
+
+void AVRGameModeBase::ResetSessionStats()
+{
+	JoinCount = 0;
+	JoinTotalSeconds = 0.0;
+	JoinMaxSeconds = 0.0;
+	GCCount = 0;
+	GCTotalSeconds = 0.0;
+	GCMaxSeconds = 0.0;
+}
+
+void AVRGameModeBase::StartBotChurn(int32 BotCount, float Interval)
+{
+	GetWorldTimerManager().ClearTimer(ChurnTimer);
+
+	// 남은 봇 정리
+	for(AVRBotController* Bot : ChurnBots)
+	{
+		if(IsValid(Bot))
+		{
+			PlayerUsage.Remove(Bot);
+			ReleasePlayerPawn(Bot);
+			Bot->Destroy();
+		}
+	}
+	ChurnBots.Reset();
+
+	ChurnBotCount = FMath::Max(0, BotCount);
+	if(ChurnBotCount > 0)
+	{
+		ChurnBots.SetNumZeroed(ChurnBotCount);
+		GetWorldTimerManager().SetTimer(ChurnTimer, this, &AVRGameModeBase::ChurnStep, FMath::Max(Interval, 0.01f), true);
+	}
+}
+
+void AVRGameModeBase::ChurnStep()
+{
+	// 임의의 자리 하나를 골라 비어 있으면 접속, 차 있으면 종료
+	const int32 Slot = FMath::RandRange(0, ChurnBotCount - 1);
+	AVRBotController*& Bot = ChurnBots[Slot];
+	if(IsValid(Bot))
+	{
+		PlayerUsage.Remove(Bot);
+		ReleasePlayerPawn(Bot);
+		Bot->Destroy();
+		Bot = nullptr;
+		return;
+	}
+
+	FActorSpawnParameters Params;
+	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	Bot = GetWorld()->SpawnActor<AVRBotController>(Params);
+	if(Bot)
+	{
+		Bot->SetRandomSeed(Slot);
+		const double StartTime = FPlatformTime::Seconds();
+		RestartPlayer(Bot);
+		RecordJoin(FPlatformTime::Seconds() - StartTime);
+	}
+}
+
+void AVRGameModeBase::StartClientChurn(int32 ClientCount, float Lifetime)
+{
+	StopClientChurn();
+
+	ChurnClientCount = FMath::Max(0, ClientCount);
+	ChurnClientLifetime = FMath::Max(Lifetime, 1.f);
+	if(ChurnClientCount > 0)
+	{
+		GetWorldTimerManager().SetTimer(ClientChurnTimer, this, &AVRGameModeBase::ClientChurnStep, 0.5f, true, 0.f);
+	}
+}
+
+void AVRGameModeBase::ClientChurnStep()
+{
+	// 1. 끝난 클라이언트 정리
+	for(int32 i = ChurnClients.Num() - 1; i >= 0; i--)
+	{
+		if(FPlatformProcess::IsProcRunning(ChurnClients[i]) == false)
+		{
+			FPlatformProcess::CloseProc(ChurnClients[i]);
+			ChurnClients.RemoveAtSwap(i);
+		}
+	}
+
+	// 2. 빈 자리만큼 새 클라이언트를 띄운다(한 번에 하나씩 띄워서 접속 시간을 겹치지 않게).
+	if(ChurnClients.Num() >= ChurnClientCount)
+	{
+		return;
+	}
+
+	// 에디터 실행 파일이면 프로젝트 경로와 -game이 필요하다.
+	FString Params;
+#if WITH_EDITOR
+	Params = FString::Printf(TEXT("\"%s\" -game "), *FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath()));
+#endif
+	// 각 클라이언트는 Lifetime초 뒤 스스로 종료하고, 자기 GC/프레임 시간을 CSV로 남긴다.
+	Params += FString::Printf(TEXT("127.0.0.1:%d -nullrhi -nosound -unattended -nosplash -csvprofile -ExecCmds=\"vr.Session.ClientLifetime %.1f\""),
+		GetWorld()->URL.Port, ChurnClientLifetime * FMath::FRandRange(0.75f, 1.25f));
+
+	FProcHandle Client = FPlatformProcess::CreateProc(FPlatformProcess::ExecutablePath(), *Params, true, true, true, nullptr, 0, nullptr, nullptr);
+	if(Client.IsValid())
+	{
+		ChurnClients.Add(Client);
+	}
+	else
+	{
+		UE_LOG(LogVRProject, Warning, TEXT("Could not launch a churn client: %s %s"), FPlatformProcess::ExecutablePath(), *Params);
+	}
+}
+
+void AVRGameModeBase::StopClientChurn()
+{
+	GetWorldTimerManager().ClearTimer(ClientChurnTimer);
+	for(FProcHandle& Client : ChurnClients)
+	{
+		if(FPlatformProcess::IsProcRunning(Client))
+		{
+			FPlatformProcess::TerminateProc(Client);
+		}
+		FPlatformProcess::CloseProc(Client);
+	}
+	ChurnClients.Reset();
+	ChurnClientCount = 0;
+}
+
+// 접속/종료 반복 부하 테스트
+// 예) 서버에서 vr.Session.Churn 64 0.1 후 일정 시간 뒤 vr.Session.Report (csvprofile로 JoinMs/GCMs 기록)
+// 봇은 서버 안에서 RestartPlayer만 거치므로 네트워크 접속(PostLogin, PlayerState, 채널 열기)과 클라이언트 GC는 vr.Session.ChurnClients로 잰다.
+static FAutoConsoleCommandWithWorldAndArgs GVRSessionChurnCmd(
+	TEXT("vr.Session.Churn"),
+	TEXT("Makes N bots join and leave through the game mode. Usage: vr.Session.Churn <Bots> [Interval] (0 stops)"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		auto GameMode = World ? World->GetAuthGameMode<AVRGameModeBase>() : nullptr;
+		if(GameMode == nullptr)
+		{
+			UE_LOG(LogVRProject, Warning, TEXT("vr.Session.Churn must run on the server with AVRGameModeBase"));
+			return;
+		}
+
+		const int32 BotCount = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 64;
+		const float Interval = Args.Num() > 1 ? FCString::Atof(*Args[1]) : 0.1f;
+		GameMode->StartBotChurn(BotCount, Interval);
+	}));
+
+// 예) 데디케이티드 서버(-log -csvprofile)에서 vr.Session.ChurnClients 64 30 후 일정 시간 뒤 vr.Session.Report
+static FAutoConsoleCommandWithWorldAndArgs GVRSessionChurnClientsCmd(
+	TEXT("vr.Session.ChurnClients"),
+	TEXT("Launches N headless client processes that join this server, leave after about Lifetime seconds and are relaunched. Usage: vr.Session.ChurnClients <Clients> [Lifetime] (0 stops)"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		auto GameMode = World ? World->GetAuthGameMode<AVRGameModeBase>() : nullptr;
+		if(GameMode == nullptr || World->GetNetMode() == NM_Standalone)
+		{
+			UE_LOG(LogVRProject, Warning, TEXT("vr.Session.ChurnClients must run on a listen or dedicated server with AVRGameModeBase"));
+			return;
+		}
+
+		const int32 ClientCount = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 64;
+		const float Lifetime = Args.Num() > 1 ? FCString::Atof(*Args[1]) : 30.f;
+		GameMode->StartClientChurn(ClientCount, Lifetime);
+	}));
+
+static FAutoConsoleCommandWithWorld GVRSessionReportCmd(
+	TEXT("vr.Session.Report"),
+	TEXT("Logs join latency, GC times and per-player budget usage."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if(auto GameMode = World ? World->GetAuthGameMode<AVRGameModeBase>() : nullptr)
+		{
+			GameMode->ReportSession();
+		}
+	}));
+
+static FAutoConsoleCommandWithWorld GVRSessionResetCmd(
+	TEXT("vr.Session.ResetStats"),
+	TEXT("Clears join latency and GC measurements."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if(auto GameMode = World ? World->GetAuthGameMode<AVRGameModeBase>() : nullptr)
+		{
+			GameMode->ResetSessionStats();
+		}
+	}));
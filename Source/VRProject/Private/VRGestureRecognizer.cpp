@@ -0,0 +1,114 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "VRGestureRecognizer.h"
+#include "Math/VectorRegister.h"
+
+void FVRHandJoints::SetFromKeyPositions(const TArray<FVector>& KeyPositions)
+{
+	bValid = KeyPositions.Num() == EHandKeypointCount;
+	if(bValid == false)
+	{
+		return;
+	}
+
+	for(int32 i = 0; i < EHandKeypointCount; i++)
+	{
+		Positions[i] = FVector3f(KeyPositions[i]);
+	}
+}
+
+void FVRGestureRecognizer::Evaluate(const FVRHandJoints& Left, const FVRHandJoints& Right)
+{
+	Previous[0] = Current[0];
+	Previous[1] = Current[1];
+
+	Current[0] = EvaluateHand(Left, Previous[0], Thresholds);
+	Current[1] = EvaluateHand(Right, Previous[1], Thresholds);
+}
+
+void FVRGestureRecognizer::Reset()
+{
+	Current[0] = Current[1] = EVRGesture::None;
+	Previous[0] = Previous[1] = EVRGesture::None;
+}
+
+// 네 손가락(검지, 중지, 약지, 새끼)의 특정 관절 좌표를 레인별로 모은다.
+static FORCEINLINE void GatherFingers(const FVRHandJoints& Joints, int32 Offset, VectorRegister4Float& OutX, VectorRegister4Float& OutY, VectorRegister4Float& OutZ)
+{
+	const FVector3f& I = Joints.Positions[(int32)EHandKeypoint::IndexMetacarpal + Offset];
+	const FVector3f& M = Joints.Positions[(int32)EHandKeypoint::MiddleMetacarpal + Offset];
+	const FVector3f& R = Joints.Positions[(int32)EHandKeypoint::RingMetacarpal + Offset];
+	const FVector3f& L = Joints.Positions[(int32)EHandKeypoint::LittleMetacarpal + Offset];
+	OutX = MakeVectorRegisterFloat(I.X, M.X, R.X, L.X);
+	OutY = MakeVectorRegisterFloat(I.Y, M.Y, R.Y, L.Y);
+	OutZ = MakeVectorRegisterFloat(I.Z, M.Z, R.Z, L.Z);
+}
+
+// 레인별 거리 제곱
+static FORCEINLINE VectorRegister4Float DistanceSquared(const VectorRegister4Float& AX, const VectorRegister4Float& AY, const VectorRegister4Float& AZ, const VectorRegister4Float& BX, const VectorRegister4Float& BY, const VectorRegister4Float& BZ)
+{
+	const VectorRegister4Float DX = VectorSubtract(AX, BX);
+	const VectorRegister4Float DY = VectorSubtract(AY, BY);
+	const VectorRegister4Float DZ = VectorSubtract(AZ, BZ);
+	return VectorMultiplyAdd(DZ, DZ, VectorMultiplyAdd(DY, DY, VectorMultiply(DX, DX)));
+}
+
+EVRGesture FVRGestureRecognizer::EvaluateHand(const FVRHandJoints& Joints, EVRGesture PreviousGestures, const FVRGestureThresholds& Thresholds)
+{
+	if(Joints.bValid == false)
+	{
+		return EVRGesture::None;
+	}
+
+	// 손바닥 기준점(모든 레인에 복사)
+	const FVector3f& Palm = Joints.Positions[(int32)EHandKeypoint::Palm];
+	const VectorRegister4Float PalmX = VectorSetFloat1(Palm.X);
+	const VectorRegister4Float PalmY = VectorSetFloat1(Palm.Y);
+	const VectorRegister4Float PalmZ = VectorSetFloat1(Palm.Z);
+
+	// 손가락 끝, 시작 마디(Proximal)
+	// Metacarpal 기준 오프셋: Proximal = 1, Tip = 4
+	VectorRegister4Float TipX, TipY, TipZ, ProxX, ProxY, ProxZ;
+	GatherFingers(Joints, 4, TipX, TipY, TipZ);
+	GatherFingers(Joints, 1, ProxX, ProxY, ProxZ);
+
+	// 굽힘 비율의 제곱 = |끝-손바닥|² / |마디-손바닥|²
+	const VectorRegister4Float TipDistSq = DistanceSquared(TipX, TipY, TipZ, PalmX, PalmY, PalmZ);
+	const VectorRegister4Float ProxDistSq = VectorMax(DistanceSquared(ProxX, ProxY, ProxZ, PalmX, PalmY, PalmZ), VectorSetFloat1(UE_SMALL_NUMBER));
+	const VectorRegister4Float CurlRatioSq = VectorDivide(TipDistSq, ProxDistSq);
+
+	// 잡기 중이었다면 놓는 기준을 느슨하게(히스테리시스)
+	const bool bWasGrab = EnumHasAnyFlags(PreviousGestures, EVRGesture::Grab);
+	const float Curl = bWasGrab ? Thresholds.CurlOff : Thresholds.CurlOn;
+	const int32 CurledMask = VectorMaskBits(VectorCompareLT(CurlRatioSq, VectorSetFloat1(Curl * Curl)));
+	const int32 ExtendedMask = VectorMaskBits(VectorCompareGT(CurlRatioSq, VectorSetFloat1(Thresholds.Extended * Thresholds.Extended)));
+
+	EVRGesture Result = EVRGesture::None;
+
+	// 잡기: 네 손가락 모두 굽힘
+	if(CurledMask == 0xF)
+	{
+		Result |= EVRGesture::Grab;
+	}
+
+	// 가리키기: 검지만 펴고 나머지는 굽힘(레인 0 = 검지)
+	if((ExtendedMask & 0x1) && (CurledMask & 0xE) == 0xE)
+	{
+		Result |= EVRGesture::Point;
+	}
+
+	// 집기: 엄지 끝과 검지 끝이 손 크기에 비해 충분히 가까움(주먹 상태는 제외)
+	if(EnumHasAnyFlags(Result, EVRGesture::Grab) == false)
+	{
+		const float HandSizeSq = FVector3f::DistSquared(Joints.Positions[(int32)EHandKeypoint::Wrist], Joints.Positions[(int32)EHandKeypoint::MiddleProximal]);
+		const float PinchDistSq = FVector3f::DistSquared(Joints.Positions[(int32)EHandKeypoint::ThumbTip], Joints.Positions[(int32)EHandKeypoint::IndexTip]);
+		const float Pinch = EnumHasAnyFlags(PreviousGestures, EVRGesture::Pinch) ? Thresholds.PinchOff : Thresholds.PinchOn;
+		if(PinchDistSq < Pinch * Pinch * HandSizeSq)
+		{
+			Result |= EVRGesture::Pinch;
+		}
+	}
+
+	return Result;
+}
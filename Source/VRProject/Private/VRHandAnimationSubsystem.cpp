@@ -0,0 +1,193 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "VRHandAnimationSubsystem.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
+#include "VRProject.h"
+#include "VRHitchDetectorSubsystem.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Hands Evaluated"), STAT_VRHandsEvaluated, STATGROUP_VRProject);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Hands Skipped"), STAT_VRHandsSkipped, STATGROUP_VRProject);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Hands Interpolated"), STAT_VRHandsInterpolated, STATGROUP_VRProject);
+
+static TAutoConsoleVariable<int32> CVarHandBoneBudget(
+	TEXT("vr.HandAnim.BoneBudget"),
+	2000,
+	TEXT("Max number of hand bones evaluated per frame. Local hands are always evaluated but still count against the budget."));
+
+static TAutoConsoleVariable<float> CVarHandNearDistance(
+	TEXT("vr.HandAnim.NearDistance"),
+	500.f,
+	TEXT("Remote hands closer than this are updated every frame."));
+
+static TAutoConsoleVariable<float> CVarHandFarDistance(
+	TEXT("vr.HandAnim.FarDistance"),
+	2000.f,
+	TEXT("Remote hands further than this are updated at the lowest rate and not interpolated."));
+
+void UVRHandAnimationSubsystem::RegisterHand(USkeletalMeshComponent* HandMesh)
+{
+	if(HandMesh == nullptr)
+	{
+		return;
+	}
+
+	FHandEntry Entry;
+	Entry.Mesh = HandMesh;
+	Hands.Add(Entry);
+}
+
+void UVRHandAnimationSubsystem::UnregisterHand(USkeletalMeshComponent* HandMesh)
+{
+	Hands.RemoveAll([HandMesh](const FHandEntry& Entry)
+	{
+		return Entry.Mesh.Get() == HandMesh;
+	});
+
+	// 원래대로 돌려놓는다.
+	if(HandMesh)
+	{
+		HandMesh->EnableExternalTickRateControl(false);
+	}
+}
+
+// 여기서 정한 결과는 다음 프레임 컴포넌트 Tick에 반영된다.
+void UVRHandAnimationSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	VR_FEATURE_SCOPE(HandAnimation);
+
+	// 파괴된 손 정리
+	Hands.RemoveAll([](const FHandEntry& Entry)
+	{
+		return Entry.Mesh.IsValid() == false;
+	});
+
+	NumEvaluated = 0;
+	NumSkipped = 0;
+	NumInterpolated = 0;
+
+	// 중요도 기준이 될 시점(로컬 카메라)
+	FVector ViewLocation = FVector::ZeroVector;
+	bool bHasView = false;
+	APlayerController* PC = GetWorld()->GetFirstPlayerController();
+	if(PC && PC->PlayerCameraManager)
+	{
+		ViewLocation = PC->PlayerCameraManager->GetCameraLocation();
+		bHasView = true;
+	}
+
+	const float NearDistance = CVarHandNearDistance.GetValueOnGameThread();
+	const float FarDistance = FMath::Max(NearDistance, CVarHandFarDistance.GetValueOnGameThread());
+	int32 Budget = CVarHandBoneBudget.GetValueOnGameThread();
+
+	// 1. 로컬 손은 항상 전체 갱신, 원격 손은 중요도 계산
+	TArray<int32, TInlineAllocator<64>> RemoteHands;
+	for(int32 i = 0; i < Hands.Num(); i++)
+	{
+		FHandEntry& Entry = Hands[i];
+		USkeletalMeshComponent* Mesh = Entry.Mesh.Get();
+		APawn* OwnerPawn = Cast<APawn>(Mesh->GetOwner());
+
+		if(OwnerPawn && OwnerPawn->IsLocallyControlled())
+		{
+			Mesh->EnableExternalTickRateControl(false);
+			Budget -= Mesh->GetNumBones();
+			NumEvaluated++;
+			continue;
+		}
+
+		Mesh->EnableExternalTickRateControl(true);
+		Entry.AccumulatedDeltaTime += DeltaTime;
+		Entry.FramesSinceEvaluation++;
+
+		const float Distance = bHasView ? FVector::Dist(ViewLocation, Mesh->GetComponentLocation()) : 0.f;
+		const bool bRendered = Mesh->WasRecentlyRendered(0.2f);
+
+		// 가까울수록, 화면에 보일수록 중요하다.
+		Entry.Significance = (bRendered ? 1.f : 0.25f) / (1.f + Distance);
+
+		// 거리에 따라 갱신 주기 결정
+		if(bRendered == false)
+		{
+			Entry.UpdateInterval = 8;
+			Entry.bInterpolate = false;
+		}
+		else if(Distance <= NearDistance)
+		{
+			Entry.UpdateInterval = 1;
+			Entry.bInterpolate = false;
+		}
+		else if(Distance <= FarDistance)
+		{
+			Entry.UpdateInterval = 2;
+			Entry.bInterpolate = true;
+		}
+		else
+		{
+			Entry.UpdateInterval = 4;
+			Entry.bInterpolate = false;
+		}
+
+		RemoteHands.Add(i);
+	}
+
+	// 2. 중요도가 높은 손부터 예산 안에서 평가
+	RemoteHands.Sort([this](int32 A, int32 B)
+	{
+		return Hands[A].Significance > Hands[B].Significance;
+	});
+
+	for(int32 Index : RemoteHands)
+	{
+		FHandEntry& Entry = Hands[Index];
+		USkeletalMeshComponent* Mesh = Entry.Mesh.Get();
+		const int32 NumBones = Mesh->GetNumBones();
+
+		const bool bDue = Entry.FramesSinceEvaluation >= Entry.UpdateInterval;
+		const bool bEvaluate = bDue && Budget >= NumBones;
+
+		Mesh->SetExternalTickRate(static_cast<uint8>(Entry.UpdateInterval));
+		Mesh->EnableExternalEvaluationRateLimiting(Entry.UpdateInterval > 1);
+
+		if(bEvaluate)
+		{
+			// 건너뛴 시간만큼 한 번에 진행시킨다.
+			Mesh->SetExternalDeltaTime(Entry.AccumulatedDeltaTime);
+			Mesh->EnableExternalUpdate(true);
+			Mesh->EnableExternalInterpolation(false);
+			Entry.AccumulatedDeltaTime = 0.f;
+			Entry.FramesSinceEvaluation = 0;
+			Budget -= NumBones;
+			NumEvaluated++;
+		}
+		else
+		{
+			Mesh->EnableExternalUpdate(false);
+			Mesh->EnableExternalInterpolation(Entry.bInterpolate);
+			if(Entry.bInterpolate)
+			{
+				// 지난 평가 이후 지난 프레임 비율만큼 이전 포즈에서 새 포즈로 보간한다(예산 때문에 밀리면 새 포즈에 머문다).
+				Mesh->SetExternalInterpolationAlpha(FMath::Clamp((float)Entry.FramesSinceEvaluation / Entry.UpdateInterval, 0.f, 1.f));
+				NumInterpolated++;
+			}
+			else
+			{
+				NumSkipped++;
+			}
+		}
+	}
+
+	SET_DWORD_STAT(STAT_VRHandsEvaluated, NumEvaluated);
+	SET_DWORD_STAT(STAT_VRHandsSkipped, NumSkipped);
+	SET_DWORD_STAT(STAT_VRHandsInterpolated, NumInterpolated);
+}
+
+TStatId UVRHandAnimationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UVRHandAnimationSubsystem, STATGROUP_Tickables);
+}
@@ -0,0 +1,235 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "VRHandTrackingComponent.h"
+#include "HeadMountedDisplayFunctionLibrary.h"
+#include "GameFramework/Pawn.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "VRProject.h"
+
+// 관절 기록(한 줄 = 한 프레임 한 손: 시간, 손, 유효, 관절 26개 x,y,z)
+static bool GVRGestureRecording = false;
+static FString GVRGestureRecordPath;
+static TArray<FString> GVRGestureRecordLines;
+static double GVRGestureRecordTime = 0.0;
+
+UVRHandTrackingComponent::UVRHandTrackingComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	// 입력처럼 다른 처리보다 먼저
+	PrimaryComponentTick.TickGroup = TG_PrePhysics;
+}
+
+EVRGesture UVRHandTrackingComponent::GetGestures(EControllerHand Hand) const
+{
+	return Recognizer.GetGestures(Hand == EControllerHand::Left ? 0 : 1);
+}
+
+void UVRHandTrackingComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	// 로컬 플레이어만 손 추적 데이터를 읽는다.
+	APawn* OwnerPawn = Cast<APawn>(GetOwner());
+	if(bUseHandTracking == false || OwnerPawn == nullptr || OwnerPawn->IsLocallyControlled() == false)
+	{
+		return;
+	}
+
+	// 1. 양손 관절 읽기
+	const EControllerHand Hands[2] = { EControllerHand::Left, EControllerHand::Right };
+	for(int32 i = 0; i < 2; i++)
+	{
+		FXRMotionControllerData Data;
+		UHeadMountedDisplayFunctionLibrary::GetMotionControllerData(this, Hands[i], Data);
+		if(Data.bValid && Data.DeviceVisualType == EXRVisualType::Hand)
+		{
+			Joints[i].SetFromKeyPositions(Data.HandKeyPositions);
+		}
+		else
+		{
+			Joints[i].bValid = false;
+		}
+	}
+
+	RecordFrame(DeltaTime);
+
+	// 2. 제스처 인식
+	Recognizer.Evaluate(Joints[0], Joints[1]);
+
+	// 3. 시작/종료 알림
+	const EVRGesture AllGestures[3] = { EVRGesture::Pinch, EVRGesture::Grab, EVRGesture::Point };
+	for(int32 i = 0; i < 2; i++)
+	{
+		const EVRGesture Started = Recognizer.GetStarted(i);
+		const EVRGesture Ended = Recognizer.GetEnded(i);
+		for(EVRGesture Gesture : AllGestures)
+		{
+			if(EnumHasAnyFlags(Started, Gesture))
+			{
+				OnGesture.Broadcast(Hands[i], Gesture, true);
+			}
+			if(EnumHasAnyFlags(Ended, Gesture))
+			{
+				OnGesture.Broadcast(Hands[i], Gesture, false);
+			}
+		}
+	}
+}
+
+void UVRHandTrackingComponent::RecordFrame(float DeltaTime)
+{
+	if(GVRGestureRecording == false)
+	{
+		return;
+	}
+
+	GVRGestureRecordTime += DeltaTime;
+	for(int32 i = 0; i < 2; i++)
+	{
+		FString Line = FString::Printf(TEXT("%.4f,%d,%d"), GVRGestureRecordTime, i, Joints[i].bValid ? 1 : 0);
+		for(const FVector3f& Position : Joints[i].Positions)
+		{
+			Line += FString::Printf(TEXT(",%.3f,%.3f,%.3f"), Position.X, Position.Y, Position.Z);
+		}
+		GVRGestureRecordLines.Add(MoveTemp(Line));
+	}
+}
+
+// 기록한 관절 파일을 읽는다. 프레임마다 왼손/오른손 한 쌍.
+static bool LoadJointRecording(const FString& Path, TArray<FVRHandJoints>& OutFrames)
+{
+	TArray<FString> Lines;
+	if(FFileHelper::LoadFileToStringArray(Lines, *Path) == false)
+	{
+		return false;
+	}
+
+	for(const FString& Line : Lines)
+	{
+		TArray<FString> Values;
+		Line.ParseIntoArray(Values, TEXT(","));
+		if(Values.Num() != 3 + EHandKeypointCount * 3)
+		{
+			continue;
+		}
+
+		FVRHandJoints Joints;
+		Joints.bValid = FCString::Atoi(*Values[2]) != 0;
+		for(int32 j = 0; j < EHandKeypointCount; j++)
+		{
+			Joints.Positions[j] = FVector3f(FCString::Atof(*Values[3 + j * 3]), FCString::Atof(*Values[4 + j * 3]), FCString::Atof(*Values[5 + j * 3]));
+		}
+		OutFrames.Add(Joints);
+	}
+
+	// 왼손/오른손 쌍이 맞아야 한다.
+	return OutFrames.Num() % 2 == 0;
+}
+
+static FString GestureToString(EVRGesture Gestures)
+{
+	FString Result;
+	if(EnumHasAnyFlags(Gestures, EVRGesture::Pinch)) { Result += TEXT("Pinch "); }
+	if(EnumHasAnyFlags(Gestures, EVRGesture::Grab)) { Result += TEXT("Grab "); }
+	if(EnumHasAnyFlags(Gestures, EVRGesture::Point)) { Result += TEXT("Point "); }
+	return Result.IsEmpty() ? TEXT("None") : Result.TrimEnd();
+}
+
+static FAutoConsoleCommand GVRGestureRecordCmd(
+	TEXT("vr.Gesture.Record"),
+	TEXT("Starts recording hand joints of the local player. Usage: vr.Gesture.Record [FileName]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		GVRGestureRecordPath = FPaths::ProjectSavedDir() / TEXT("HandJoints") / (Args.Num() > 0 ? Args[0] : TEXT("HandJoints.csv"));
+		GVRGestureRecordLines.Reset();
+		GVRGestureRecordTime = 0.0;
+		GVRGestureRecording = true;
+	}));
+
+static FAutoConsoleCommand GVRGestureStopRecordCmd(
+	TEXT("vr.Gesture.StopRecord"),
+	TEXT("Stops recording hand joints and writes the file."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		if(GVRGestureRecording == false)
+		{
+			return;
+		}
+		GVRGestureRecording = false;
+		FFileHelper::SaveStringArrayToFile(GVRGestureRecordLines, *GVRGestureRecordPath);
+		UE_LOG(LogVRProject, Display, TEXT("Wrote %d hand joint frames to %s"), GVRGestureRecordLines.Num() / 2, *GVRGestureRecordPath);
+		GVRGestureRecordLines.Empty();
+	}));
+
+// 기록된 관절 데이터로 인식기를 돌려 제스처 변화를 출력한다(HMD 없이 확인 가능).
+static FAutoConsoleCommand GVRGestureReplayCmd(
+	TEXT("vr.Gesture.Replay"),
+	TEXT("Runs the gesture recognizer over a recorded joint stream and logs gesture changes. Usage: vr.Gesture.Replay [FileName]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const FString Path = FPaths::ProjectSavedDir() / TEXT("HandJoints") / (Args.Num() > 0 ? Args[0] : TEXT("HandJoints.csv"));
+		TArray<FVRHandJoints> Frames;
+		if(LoadJointRecording(Path, Frames) == false)
+		{
+			UE_LOG(LogVRProject, Warning, TEXT("Failed to load hand joint recording %s"), *Path);
+			return;
+		}
+
+		FVRGestureRecognizer Recognizer;
+		for(int32 Frame = 0; Frame < Frames.Num() / 2; Frame++)
+		{
+			Recognizer.Evaluate(Frames[Frame * 2], Frames[Frame * 2 + 1]);
+			for(int32 Hand = 0; Hand < 2; Hand++)
+			{
+				if(Recognizer.GetStarted(Hand) != EVRGesture::None || Recognizer.GetEnded(Hand) != EVRGesture::None)
+				{
+					UE_LOG(LogVRProject, Display, TEXT("Frame %5d %s: %s"), Frame, Hand == 0 ? TEXT("Left ") : TEXT("Right"), *GestureToString(Recognizer.GetGestures(Hand)));
+				}
+			}
+		}
+	}));
+
+// 인식기 마이크로벤치마크: 두 손 평가 1회당 평균 시간
+static FAutoConsoleCommand GVRGestureBenchmarkCmd(
+	TEXT("vr.Gesture.Benchmark"),
+	TEXT("Measures the time of one two-hand gesture evaluation. Uses a recording if given. Usage: vr.Gesture.Benchmark [Iterations] [FileName]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const int32 Iterations = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 1000000;
+
+		TArray<FVRHandJoints> Frames;
+		if(Args.Num() > 1)
+		{
+			LoadJointRecording(FPaths::ProjectSavedDir() / TEXT("HandJoints") / Args[1], Frames);
+		}
+		if(Frames.Num() < 2)
+		{
+			// 기록이 없으면 임의의 손 모양으로 대신한다.
+			FRandomStream Random(0);
+			Frames.SetNum(64);
+			for(FVRHandJoints& Joints : Frames)
+			{
+				Joints.bValid = true;
+				for(FVector3f& Position : Joints.Positions)
+				{
+					Position = FVector3f(Random.FRandRange(-10.f, 10.f), Random.FRandRange(-10.f, 10.f), Random.FRandRange(-10.f, 10.f));
+				}
+			}
+		}
+
+		FVRGestureRecognizer Recognizer;
+		int32 Checksum = 0;
+		const int32 NumPairs = Frames.Num() / 2;
+		const double Start = FPlatformTime::Seconds();
+		for(int32 i = 0; i < Iterations; i++)
+		{
+			const int32 Frame = i % NumPairs;
+			Recognizer.Evaluate(Frames[Frame * 2], Frames[Frame * 2 + 1]);
+			Checksum += (int32)Recognizer.GetGestures(0) + (int32)Recognizer.GetGestures(1);
+		}
+		const double Elapsed = FPlatformTime::Seconds() - Start;
+
+		UE_LOG(LogVRProject, Display, TEXT("Gesture recognizer: %d two-hand evaluations, %.1f ns each (checksum %d)"), Iterations, Elapsed * 1e9 / Iterations, Checksum);
+	}));
@@ -0,0 +1,223 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "VRHitchDetectorSubsystem.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Engine/Engine.h"
+#include "HeadMountedDisplayFunctionLibrary.h"
+
+static TAutoConsoleVariable<int32> CVarHitchEnable(
+	TEXT("vr.Hitch.Enable"),
+	!UE_BUILD_SHIPPING,
+	TEXT("Enables the VRProject frame hitch detector. It only records while a game or PIE world is running (headless and server runs included)."));
+
+static TAutoConsoleVariable<float> CVarHitchBudgetMs(
+	TEXT("vr.Hitch.BudgetMs"),
+	0.f,
+	TEXT("Frames longer than this are reported as hitches. 0: one HMD refresh interval estimated from recent frames, the server tick interval on a dedicated server, or vr.Hitch.HeadlessBudgetMs without an HMD."));
+
+static TAutoConsoleVariable<float> CVarHitchHeadlessBudgetMs(
+	TEXT("vr.Hitch.HeadlessBudgetMs"),
+	11.1f,
+	TEXT("Hitch budget when vr.Hitch.BudgetMs is 0 and no HMD is enabled (e.g. -nullrhi runs). Default is one 90 Hz frame."));
+
+static TAutoConsoleVariable<int32> CVarHitchHistoryFrames(
+	TEXT("vr.Hitch.HistoryFrames"),
+	120,
+	TEXT("Number of recent frames written to the hitch report. Read at startup."));
+
+static TAutoConsoleVariable<float> CVarHitchDumpCooldown(
+	TEXT("vr.Hitch.DumpCooldown"),
+	1.f,
+	TEXT("Minimum seconds between two hitch reports."));
+
+// 헤드셋 주사율 후보(Hz)
+static const float GVRRefreshRates[] = { 60.f, 72.f, 80.f, 90.f, 120.f, 144.f };
+
+static const TCHAR* GVRFeatureNames[] =
+{
+	TEXT("PawnTick"),
+	TEXT("TeleportAim"),
+	TEXT("TeleportBeam"),
+	TEXT("Crosshair"),
+	TEXT("Grabbing"),
+	TEXT("DebugRemoteGrab"),
+	TEXT("Input"),
+	TEXT("Fire"),
+	TEXT("Grab"),
+	TEXT("Warp"),
+	TEXT("RemoteGrabPull"),
+	TEXT("HandAnimation"),
+	TEXT("Significance"),
+};
+static_assert(UE_ARRAY_COUNT(GVRFeatureNames) == (int32)EVRFeature::Count, "GVRFeatureNames must match EVRFeature");
+
+double FVRFeatureScope::FrameSeconds[(int32)EVRFeature::Count] = {};
+
+FVRFeatureScope::FVRFeatureScope(EVRFeature InFeature)
+	: Feature(InFeature)
+	, StartCycles(FPlatformTime::Cycles64())
+{
+}
+
+FVRFeatureScope::~FVRFeatureScope()
+{
+	FrameSeconds[(int32)Feature] += FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+}
+
+void UVRHitchDetectorSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	History.SetNum(FMath::Max(1, CVarHitchHistoryFrames.GetValueOnGameThread()));
+	LastFrameTime = FPlatformTime::Seconds();
+	EndFrameHandle = FCoreDelegates::OnEndFrame.AddUObject(this, &UVRHitchDetectorSubsystem::OnEndFrame);
+}
+
+void UVRHitchDetectorSubsystem::Deinitialize()
+{
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+
+	Super::Deinitialize();
+}
+
+void UVRHitchDetectorSubsystem::OnEndFrame()
+{
+	const double Now = FPlatformTime::Seconds();
+	const double FrameMs = (Now - LastFrameTime) * 1000.0;
+	LastFrameTime = Now;
+
+	// 에디터 월드만 있을 때는 기록하지 않는다.
+	if(CVarHitchEnable.GetValueOnGameThread() == 0 || IsArmed() == false)
+	{
+		FMemory::Memzero(FVRFeatureScope::FrameSeconds);
+		HistoryHead = 0;
+		HistoryNum = 0;
+		BudgetMs = 0.0;
+		return;
+	}
+
+	// 이번 프레임 기록
+	FFrameRecord& Record = History[HistoryHead];
+	Record.FrameNumber = GFrameCounter;
+	Record.FrameMs = FrameMs;
+	for(int32 i = 0; i < (int32)EVRFeature::Count; i++)
+	{
+		Record.FeatureMs[i] = (float)(FVRFeatureScope::FrameSeconds[i] * 1000.0);
+	}
+	FMemory::Memzero(FVRFeatureScope::FrameSeconds);
+
+	HistoryHead = (HistoryHead + 1) % History.Num();
+	HistoryNum = FMath::Min(HistoryNum + 1, History.Num());
+
+	// 주사율 추정은 가끔만 다시 한다.
+	if(BudgetMs <= 0.0 || GFrameCounter % History.Num() == 0)
+	{
+		UpdateBudget();
+	}
+
+	// 예산을 넘으면 기록 저장(너무 자주 저장하지 않도록 쿨다운)
+	if(BudgetMs > 0.0 && FrameMs > BudgetMs && Now - LastDumpTime > CVarHitchDumpCooldown.GetValueOnGameThread())
+	{
+		LastDumpTime = Now;
+		DumpHistory(FrameMs);
+	}
+}
+
+bool UVRHitchDetectorSubsystem::IsArmed() const
+{
+	for(const FWorldContext& Context : GEngine->GetWorldContexts())
+	{
+		if(Context.World() && (Context.WorldType == EWorldType::Game || Context.WorldType == EWorldType::PIE))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void UVRHitchDetectorSubsystem::UpdateBudget()
+{
+	const float FixedBudgetMs = CVarHitchBudgetMs.GetValueOnGameThread();
+	if(FixedBudgetMs > 0.f)
+	{
+		BudgetMs = FixedBudgetMs;
+		return;
+	}
+
+	// 데디케이티드 서버는 서버 Tick 간격(30 Hz 서버면 33.3 ms)을 예산으로 쓴다.
+	if(IsRunningDedicatedServer())
+	{
+		const float TickRate = GEngine->GetMaxTickRate(0.f, false);
+		BudgetMs = TickRate > 0.f ? 1000.0 / TickRate : CVarHitchHeadlessBudgetMs.GetValueOnGameThread();
+		return;
+	}
+
+	// HMD 없는 실행(-nullrhi 등)은 주사율을 알 수 없으므로 고정 예산을 쓴다.
+	if(UHeadMountedDisplayFunctionLibrary::IsHeadMountedDisplayEnabled() == false)
+	{
+		BudgetMs = CVarHitchHeadlessBudgetMs.GetValueOnGameThread();
+		return;
+	}
+
+	// 프레임은 헤드셋 화면 갱신에 맞춰 끝나므로, 빠른 쪽 프레임 시간이 곧 주사율 간격이다.
+	// 최근 프레임의 하위 10% 시간을 가장 가까운 헤드셋 주사율로 맞춘다.
+	if(HistoryNum < FMath::Min(30, History.Num()))
+	{
+		return;
+	}
+	TArray<double, TInlineAllocator<256>> FrameTimes;
+	for(int32 i = 0; i < HistoryNum; i++)
+	{
+		FrameTimes.Add(History[i].FrameMs);
+	}
+	FrameTimes.Sort();
+	const double FastFrameMs = FrameTimes[FrameTimes.Num() / 10];
+	if(FastFrameMs <= 0.0)
+	{
+		return;
+	}
+
+	const float MeasuredHz = 1000.f / FastFrameMs;
+	float RefreshRate = GVRRefreshRates[0];
+	for(float Rate : GVRRefreshRates)
+	{
+		if(FMath::Abs(Rate - MeasuredHz) < FMath::Abs(RefreshRate - MeasuredHz))
+		{
+			RefreshRate = Rate;
+		}
+	}
+	BudgetMs = 1000.0 / RefreshRate;
+}
+
+void UVRHitchDetectorSubsystem::DumpHistory(double HitchFrameMs)
+{
+	FString Csv = TEXT("Frame,FrameMs");
+	for(const TCHAR* Name : GVRFeatureNames)
+	{
+		Csv += TEXT(",");
+		Csv += Name;
+	}
+	Csv += LINE_TERMINATOR;
+
+	// 오래된 프레임부터 순서대로
+	const int32 Start = (HistoryHead - HistoryNum + History.Num()) % History.Num();
+	for(int32 i = 0; i < HistoryNum; i++)
+	{
+		const FFrameRecord& Record = History[(Start + i) % History.Num()];
+		Csv += FString::Printf(TEXT("%llu,%.3f"), Record.FrameNumber, Record.FrameMs);
+		for(float FeatureMs : Record.FeatureMs)
+		{
+			Csv += FString::Printf(TEXT(",%.4f"), FeatureMs);
+		}
+		Csv += LINE_TERMINATOR;
+	}
+
+	const FString FileName = FPaths::ProfilingDir() / TEXT("VRHitches") / FString::Printf(TEXT("Hitch_%s_%llu.csv"), *FDateTime::Now().ToString(), (uint64)GFrameCounter);
+	if(FFileHelper::SaveStringToFile(Csv, *FileName))
+	{
+		UE_LOG(LogVRProject, Warning, TEXT("Hitch %.2f ms at frame %llu, wrote %d frames to %s"), HitchFrameMs, (uint64)GFrameCounter, HistoryNum, *FileName);
+	}
+}
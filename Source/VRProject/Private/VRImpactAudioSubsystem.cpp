@@ -0,0 +1,298 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "VRImpactAudioSubsystem.h"
+#include "Components/AudioComponent.h"
+#include "Components/PrimitiveComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/StreamableManager.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/WorldSettings.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Sound/SoundBase.h"
+#include "Sound/SoundAttenuation.h"
+#include "VRProject.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Impact Voices Requested"), STAT_VRImpactVoicesRequested, STATGROUP_VRProject);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Impact Voices Culled"), STAT_VRImpactVoicesCulled, STATGROUP_VRProject);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Impact Voices Played"), STAT_VRImpactVoicesPlayed, STATGROUP_VRProject);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Impact Tracked Bodies"), STAT_VRImpactTrackedBodies, STATGROUP_VRProject);
+
+bool UVRImpactAudioSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UVRImpactAudioSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// 소리가 나지 않는 데디케이티드 서버는 풀을 만들지 않는다.
+	if(InWorld.GetNetMode() == NM_DedicatedServer)
+	{
+		return;
+	}
+
+	// 충돌음 에셋 미리 로드
+	TArray<FSoftObjectPath> SoundPaths;
+	for(const FVRImpactSoundTier& Tier : ImpactSounds)
+	{
+		if(Tier.Sound.ToSoftObjectPath().IsValid())
+		{
+			SoundPaths.Add(Tier.Sound.ToSoftObjectPath());
+		}
+	}
+	if(Attenuation.ToSoftObjectPath().IsValid())
+	{
+		SoundPaths.Add(Attenuation.ToSoftObjectPath());
+	}
+	SoundsHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(SoundPaths);
+
+	// 1. 오디오 컴포넌트 풀 미리 만들기
+	AWorldSettings* PoolOwner = InWorld.GetWorldSettings();
+	for(int32 i = 0; i < PoolSize; i++)
+	{
+		UAudioComponent* Voice = NewObject<UAudioComponent>(PoolOwner);
+		Voice->bAutoActivate = false;
+		Voice->bAutoDestroy = false;
+		Voice->bAllowSpatialization = true;
+		// 감쇠 에셋이 없으면 HRTF(Resonance) 공간화만 켠다.
+		Voice->bOverrideAttenuation = true;
+		Voice->AttenuationOverrides.bSpatialize = true;
+		Voice->AttenuationOverrides.SpatializationAlgorithm = ESoundSpatializationAlgorithm::SPATIALIZATION_HRTF;
+		Voice->AttenuationOverrides.FalloffDistance = MaxAudibleDistance;
+		Voice->RegisterComponentWithWorld(&InWorld);
+		Pool.Add(Voice);
+	}
+	PoolVoiceOwners.SetNum(Pool.Num());
+}
+
+void UVRImpactAudioSubsystem::Deinitialize()
+{
+	for(auto& Pair : TrackedBodies)
+	{
+		if(UPrimitiveComponent* Body = Pair.Key.Get())
+		{
+			UntrackBody(Body, Pair.Value);
+		}
+	}
+	TrackedBodies.Empty();
+
+	for(UAudioComponent* Voice : Pool)
+	{
+		if(Voice)
+		{
+			Voice->DestroyComponent();
+		}
+	}
+	Pool.Empty();
+
+	Super::Deinitialize();
+}
+
+void UVRImpactAudioSubsystem::TrackBody(UPrimitiveComponent* Body)
+{
+	if(Body == nullptr)
+	{
+		return;
+	}
+
+	const float Now = GetWorld()->GetTimeSeconds();
+	if(FTrackedBody* Tracked = TrackedBodies.Find(Body))
+	{
+		// 이미 추적 중이면 시간만 연장
+		Tracked->TrackEndTime = Now + TrackDuration;
+		return;
+	}
+
+	FTrackedBody Tracked;
+	Tracked.TrackEndTime = Now + TrackDuration;
+	Tracked.bPrevNotifyRigidBodyCollision = Body->BodyInstance.bNotifyRigidBodyCollision;
+	TrackedBodies.Add(Body, Tracked);
+
+	// 충돌 이벤트 받기
+	Body->SetNotifyRigidBodyCollision(true);
+	Body->OnComponentHit.AddUniqueDynamic(this, &UVRImpactAudioSubsystem::OnBodyHit);
+}
+
+void UVRImpactAudioSubsystem::UntrackBody(UPrimitiveComponent* Body, const FTrackedBody& Tracked)
+{
+	Body->OnComponentHit.RemoveDynamic(this, &UVRImpactAudioSubsystem::OnBodyHit);
+	Body->SetNotifyRigidBodyCollision(Tracked.bPrevNotifyRigidBodyCollision);
+}
+
+int32 UVRImpactAudioSubsystem::FindFreeVoice() const
+{
+	for(int32 i = 0; i < Pool.Num(); i++)
+	{
+		if(Pool[i]->IsPlaying() == false)
+		{
+			return i;
+		}
+	}
+	return INDEX_NONE;
+}
+
+void UVRImpactAudioSubsystem::OnBodyHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit)
+{
+	VoicesRequested++;
+
+	FTrackedBody* Tracked = TrackedBodies.Find(HitComponent);
+	const float Impulse = NormalImpulse.Size();
+	const float Now = GetWorld()->GetTimeSeconds();
+
+	// 1. 약한 충돌, 프레임 예산 초과, 같은 물체 연속 충돌은 거른다.
+	if(Tracked == nullptr || Impulse < MinImpulse || VoicesPlayed >= MaxVoicesPerFrame || Now - Tracked->LastPlayTime < MinRetriggerInterval)
+	{
+		VoicesCulled++;
+		return;
+	}
+
+	// 2. 듣는 위치에서 너무 멀면 거른다.
+	const FVector Location = Hit.ImpactPoint;
+	APlayerController* PC = GetWorld()->GetFirstPlayerController();
+	if(PC && PC->PlayerCameraManager && FVector::DistSquared(PC->PlayerCameraManager->GetCameraLocation(), Location) > FMath::Square(MaxAudibleDistance))
+	{
+		VoicesCulled++;
+		return;
+	}
+
+	// 3. 물체당 동시 재생 수 제한
+	int32 ObjectVoices = 0;
+	for(int32 i = 0; i < Pool.Num(); i++)
+	{
+		if(PoolVoiceOwners[i].Get() == HitComponent && Pool[i]->IsPlaying())
+		{
+			ObjectVoices++;
+		}
+	}
+	if(ObjectVoices >= MaxVoicesPerObject)
+	{
+		VoicesCulled++;
+		return;
+	}
+
+	// 4. 충격량에 맞는 소리 고르기(가장 큰 구간)
+	const FVRImpactSoundTier* Chosen = nullptr;
+	for(const FVRImpactSoundTier& Tier : ImpactSounds)
+	{
+		if(Impulse >= Tier.MinImpulse && (Chosen == nullptr || Tier.MinImpulse >= Chosen->MinImpulse))
+		{
+			Chosen = &Tier;
+		}
+	}
+	USoundBase* Sound = Chosen ? Chosen->Sound.Get() : nullptr;
+	const int32 VoiceIndex = FindFreeVoice();
+	if(Sound == nullptr || VoiceIndex == INDEX_NONE)
+	{
+		VoicesCulled++;
+		return;
+	}
+
+	// 5. 풀에서 꺼내 재생
+	UAudioComponent* Voice = Pool[VoiceIndex];
+	if(USoundAttenuation* AttenuationAsset = Attenuation.Get())
+	{
+		Voice->bOverrideAttenuation = false;
+		Voice->AttenuationSettings = AttenuationAsset;
+	}
+	Voice->SetWorldLocation(Location);
+	Voice->SetSound(Sound);
+	// 구간 안에서 충격량이 클수록 크게
+	Voice->SetVolumeMultiplier(Chosen->VolumeMultiplier * FMath::Clamp(Impulse / FMath::Max(Chosen->MinImpulse, MinImpulse) * 0.5f, 0.3f, 1.f));
+	Voice->SetPitchMultiplier(FMath::FRandRange(0.95f, 1.05f));
+	Voice->Play();
+
+	PoolVoiceOwners[VoiceIndex] = HitComponent;
+	Tracked->LastPlayTime = Now;
+	VoicesPlayed++;
+}
+
+void UVRImpactAudioSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// 이번 프레임 통계
+	SET_DWORD_STAT(STAT_VRImpactVoicesRequested, VoicesRequested);
+	SET_DWORD_STAT(STAT_VRImpactVoicesCulled, VoicesCulled);
+	SET_DWORD_STAT(STAT_VRImpactVoicesPlayed, VoicesPlayed);
+	SET_DWORD_STAT(STAT_VRImpactTrackedBodies, TrackedBodies.Num());
+	CSV_CUSTOM_STAT(VRProject, ImpactVoicesRequested, VoicesRequested, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(VRProject, ImpactVoicesCulled, VoicesCulled, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(VRProject, ImpactVoicesPlayed, VoicesPlayed, ECsvCustomStatOp::Set);
+	VoicesRequested = 0;
+	VoicesCulled = 0;
+	VoicesPlayed = 0;
+
+	// 추적 시간이 끝났고 잠든 물체는 추적 해제
+	const float Now = GetWorld()->GetTimeSeconds();
+	for(auto It = TrackedBodies.CreateIterator(); It; ++It)
+	{
+		UPrimitiveComponent* Body = It.Key().Get();
+		if(Body == nullptr)
+		{
+			It.RemoveCurrent();
+		}
+		else if(Now > It.Value().TrackEndTime && Body->RigidBodyIsAwake() == false)
+		{
+			UntrackBody(Body, It.Value());
+			It.RemoveCurrent();
+		}
+	}
+}
+
+TStatId UVRImpactAudioSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UVRImpactAudioSubsystem, STATGROUP_Tickables);
+}
+
+// 부하 테스트: 물리 상자를 떨어뜨려 충돌음 처리를 확인한다. stat VRProject 로 통계 확인.
+static FAutoConsoleCommandWithWorldAndArgs GVRImpactAudioStressCmd(
+	TEXT("vr.ImpactAudio.StressTest"),
+	TEXT("Drops N tracked physics cubes above the first player. Usage: vr.ImpactAudio.StressTest [Count]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		auto ImpactAudio = World ? World->GetSubsystem<UVRImpactAudioSubsystem>() : nullptr;
+		UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+		if(ImpactAudio == nullptr || Cube == nullptr)
+		{
+			return;
+		}
+
+		const int32 Count = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 500;
+
+		FVector Origin = FVector::ZeroVector;
+		if(APlayerController* PC = World->GetFirstPlayerController())
+		{
+			if(PC->GetPawn())
+			{
+				Origin = PC->GetPawn()->GetActorLocation() + PC->GetPawn()->GetActorForwardVector() * 500.f;
+			}
+		}
+
+		FActorSpawnParameters Params;
+		Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+		const int32 Columns = FMath::Max(1, FMath::CeilToInt(FMath::Sqrt((float)Count)));
+		for(int32 i = 0; i < Count; i++)
+		{
+			const FVector Location = Origin + FVector((i / Columns - Columns / 2) * 60.f, (i % Columns - Columns / 2) * 60.f, 300.f + (i % 7) * 80.f);
+			AStaticMeshActor* Prop = World->SpawnActor<AStaticMeshActor>(Location, FRotator::ZeroRotator, Params);
+			if(Prop == nullptr)
+			{
+				continue;
+			}
+
+			UStaticMeshComponent* Mesh = Prop->GetStaticMeshComponent();
+			Mesh->SetMobility(EComponentMobility::Movable);
+			Mesh->SetStaticMesh(Cube);
+			Mesh->SetWorldScale3D(FVector(0.4f));
+			Mesh->SetCollisionProfileName(UCollisionProfile::PhysicsActor_ProfileName);
+			Mesh->SetSimulatePhysics(true);
+			ImpactAudio->TrackBody(Mesh);
+		}
+
+		UE_LOG(LogVRProject, Display, TEXT("Spawned %d impact audio stress props"), Count);
+	}));
@@ -0,0 +1,301 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "VRMenuSubsystem.h"
+#include "VRProject.h"
+#include "Blueprint/UserWidget.h"
+#include "Components/WidgetComponent.h"
+#include "Components/WidgetInteractionComponent.h"
+#include "EngineUtils.h"
+#include "Engine/Level.h"
+#include "GameFramework/PlayerController.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Widget Interaction Traces"), STAT_VRWidgetInteractionTraces, STATGROUP_VRProject);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Widget Redraw Requests"), STAT_VRWidgetRedraws, STATGROUP_VRProject);
+
+bool UVRMenuSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UVRMenuSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// 맵에 배치된 월드 공간 위젯(BP_Menu 등)
+	for(TActorIterator<AActor> It(&InWorld); It; ++It)
+	{
+		RegisterActorWidgets(*It, bManualRedrawPlacedWidgets);
+	}
+
+	// 나중에 스폰되거나 스트리밍되는 위젯도 근처 검사에 넣는다.
+	ActorSpawnedHandle = InWorld.AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &UVRMenuSubsystem::OnActorSpawned));
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UVRMenuSubsystem::OnLevelAdded);
+}
+
+void UVRMenuSubsystem::RegisterActorWidgets(AActor* Actor, bool bManualRedraw)
+{
+	if(Actor == nullptr)
+	{
+		return;
+	}
+
+	TInlineComponentArray<UWidgetComponent*> Components(Actor);
+	for(UWidgetComponent* WidgetComponent : Components)
+	{
+		RegisterWidgetComponent(WidgetComponent, bManualRedraw);
+	}
+}
+
+void UVRMenuSubsystem::OnActorSpawned(AActor* Actor)
+{
+	// 스폰한 위젯은 스스로 다시 그린다고 보고 redraw 방식은 바꾸지 않는다.
+	RegisterActorWidgets(Actor, false);
+}
+
+void UVRMenuSubsystem::OnLevelAdded(ULevel* Level, UWorld* World)
+{
+	if(Level == nullptr || World != GetWorld())
+	{
+		return;
+	}
+
+	// 스트리밍된 레벨에 배치된 위젯
+	for(AActor* Actor : Level->Actors)
+	{
+		RegisterActorWidgets(Actor, bManualRedrawPlacedWidgets);
+	}
+}
+
+void UVRMenuSubsystem::Deinitialize()
+{
+	if(UWorld* World = GetWorld())
+	{
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+	}
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+
+	WidgetComponents.Empty();
+	Pools.Empty();
+	InteractionStates.Empty();
+
+	Super::Deinitialize();
+}
+
+void UVRMenuSubsystem::RegisterWidgetComponent(UWidgetComponent* WidgetComponent, bool bManualRedraw)
+{
+	if(WidgetComponent == nullptr || WidgetComponent->GetWidgetSpace() != EWidgetSpace::World)
+	{
+		return;
+	}
+
+	// 보이지 않을 때는 그리지 않고, 요청이 있을 때만 다시 그린다.
+	if(bManualRedraw)
+	{
+		WidgetComponent->SetManuallyRedraw(true);
+		WidgetComponent->SetTickWhenOffscreen(false);
+		WidgetComponent->RequestRedraw();
+	}
+	WidgetComponents.AddUnique(WidgetComponent);
+}
+
+void UVRMenuSubsystem::UnregisterWidgetComponent(UWidgetComponent* WidgetComponent)
+{
+	WidgetComponents.Remove(WidgetComponent);
+}
+
+UWidgetComponent* UVRMenuSubsystem::ShowMenu(TSubclassOf<UUserWidget> WidgetClass, const FTransform& Transform)
+{
+	if(WidgetClass == nullptr)
+	{
+		return nullptr;
+	}
+
+	UWidgetComponent* WidgetComponent = nullptr;
+	FVRMenuPool& Pool = Pools.FindOrAdd(WidgetClass);
+	while(Pool.FreeComponents.Num() > 0 && WidgetComponent == nullptr)
+	{
+		WidgetComponent = Pool.FreeComponents.Pop(false);
+		if(IsValid(WidgetComponent) == false)
+		{
+			WidgetComponent = nullptr;
+		}
+	}
+
+	// 풀에 없으면 처음 보여줄 때 만든다.
+	if(WidgetComponent == nullptr)
+	{
+		if(MenuOwner == nullptr)
+		{
+			FActorSpawnParameters Params;
+			Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+			MenuOwner = GetWorld()->SpawnActor<AActor>(Params);
+			MenuOwner->SetRootComponent(NewObject<USceneComponent>(MenuOwner));
+			MenuOwner->GetRootComponent()->RegisterComponent();
+		}
+
+		WidgetComponent = NewObject<UWidgetComponent>(MenuOwner);
+		WidgetComponent->SetWidgetSpace(EWidgetSpace::World);
+		WidgetComponent->SetWidgetClass(WidgetClass);
+		WidgetComponent->SetDrawAtDesiredSize(true);
+		WidgetComponent->SetCollisionProfileName(TEXT("UI"));
+		WidgetComponent->SetupAttachment(MenuOwner->GetRootComponent());
+		WidgetComponent->RegisterComponent();
+		MenuOwner->AddInstanceComponent(WidgetComponent);
+	}
+
+	WidgetComponent->SetWorldTransform(Transform);
+	WidgetComponent->SetVisibility(true);
+	WidgetComponent->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+	RegisterWidgetComponent(WidgetComponent);
+	return WidgetComponent;
+}
+
+void UVRMenuSubsystem::HideMenu(UWidgetComponent* WidgetComponent)
+{
+	if(IsValid(WidgetComponent) == false)
+	{
+		return;
+	}
+
+	WidgetComponent->SetVisibility(false);
+	WidgetComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	UnregisterWidgetComponent(WidgetComponent);
+
+	if(UClass* WidgetClass = WidgetComponent->GetWidgetClass())
+	{
+		Pools.FindOrAdd(WidgetClass).FreeComponents.Add(WidgetComponent);
+	}
+}
+
+void UVRMenuSubsystem::RequestRedraw(const UUserWidget* Widget)
+{
+	for(const TWeakObjectPtr<UWidgetComponent>& WeakComponent : WidgetComponents)
+	{
+		UWidgetComponent* WidgetComponent = WeakComponent.Get();
+		if(WidgetComponent && WidgetComponent->GetUserWidgetObject() == Widget)
+		{
+			WidgetComponent->RequestRedraw();
+			INC_DWORD_STAT(STAT_VRWidgetRedraws);
+		}
+	}
+}
+
+bool UVRMenuSubsystem::IsNearWidget(const FVector& Start, const FVector& End)
+{
+	for(int32 i = WidgetComponents.Num() - 1; i >= 0; i--)
+	{
+		const UWidgetComponent* WidgetComponent = WidgetComponents[i].Get();
+		// 파괴된 위젯은 정리한다.
+		if(WidgetComponent == nullptr)
+		{
+			WidgetComponents.RemoveAtSwap(i);
+			continue;
+		}
+		if(WidgetComponent->IsVisible() == false || WidgetComponent->IsRegistered() == false)
+		{
+			continue;
+		}
+
+		// 위젯 경계 구와 조준선 사이 거리
+		const FVector Center = WidgetComponent->Bounds.Origin;
+		const float Radius = WidgetComponent->Bounds.SphereRadius + ProximityMargin;
+		if(FMath::PointDistToSegmentSquared(Center, Start, End) <= Radius * Radius)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void UVRMenuSubsystem::UpdateInteraction(UWidgetInteractionComponent* Interaction)
+{
+	if(Interaction == nullptr)
+	{
+		return;
+	}
+
+	const FVector Start = Interaction->GetComponentLocation();
+	const FVector End = Start + Interaction->GetForwardVector() * Interaction->InteractionDistance;
+	const bool bNear = IsNearWidget(Start, End);
+
+	// 근처에 위젯이 없으면 트레이스하지 않는다.
+	// -> 아직 호버 중이면 한 프레임 더 트레이스해서(근처가 아니므로 아무것도 맞지 않는다) 호버를 정리한 뒤 끈다.
+	if(bNear == false)
+	{
+		const bool bStillHovering = Interaction->GetHoveredWidgetComponent() != nullptr;
+		Interaction->SetComponentTickEnabled(bStillHovering);
+		if(bStillHovering == false)
+		{
+			// 호버가 풀린 위젯을 다시 그린다.
+			FInteractionState State;
+			if(InteractionStates.RemoveAndCopyValue(Interaction, State) && State.Hovered.IsValid())
+			{
+				State.Hovered->RequestRedraw();
+				INC_DWORD_STAT(STAT_VRWidgetRedraws);
+			}
+		}
+		return;
+	}
+	Interaction->SetComponentTickEnabled(true);
+	INC_DWORD_STAT(STAT_VRWidgetInteractionTraces);
+	CSV_CUSTOM_STAT(VRProject, WidgetInteractionTraces, 1, ECsvCustomStatOp::Accumulate);
+
+	// 호버 대상이나 위젯 위 위치가 바뀌었을 때만 다시 그린다.
+	FInteractionState& State = InteractionStates.FindOrAdd(Interaction);
+	UWidgetComponent* Hovered = Interaction->GetHoveredWidgetComponent();
+	const FVector2D HitLocation = Interaction->Get2DHitLocation();
+	if(Hovered != State.Hovered.Get())
+	{
+		if(UWidgetComponent* Previous = State.Hovered.Get())
+		{
+			Previous->RequestRedraw();
+			INC_DWORD_STAT(STAT_VRWidgetRedraws);
+		}
+		if(Hovered)
+		{
+			Hovered->RequestRedraw();
+			INC_DWORD_STAT(STAT_VRWidgetRedraws);
+		}
+	}
+	else if(Hovered && FVector2D::DistSquared(HitLocation, State.HitLocation) > 1.f)
+	{
+		Hovered->RequestRedraw();
+		INC_DWORD_STAT(STAT_VRWidgetRedraws);
+	}
+	State.Hovered = Hovered;
+	State.HitLocation = HitLocation;
+}
+
+// 메뉴 풀 확인용: 첫 번째 플레이어 앞에 메뉴를 보였다 숨긴다.
+static FAutoConsoleCommandWithWorld GVRMenuToggleCmd(
+	TEXT("vr.Menu.Toggle"),
+	TEXT("Shows or hides the pooled menu widget in front of the first player."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		static TWeakObjectPtr<UWidgetComponent> ShownMenu;
+
+		auto Menu = World ? World->GetSubsystem<UVRMenuSubsystem>() : nullptr;
+		if(Menu == nullptr)
+		{
+			return;
+		}
+
+		if(ShownMenu.IsValid() && ShownMenu->GetWorld() == World)
+		{
+			Menu->HideMenu(ShownMenu.Get());
+			ShownMenu.Reset();
+			return;
+		}
+
+		APlayerController* PC = World->GetFirstPlayerController();
+		if(PC == nullptr || PC->GetPawn() == nullptr)
+		{
+			return;
+		}
+
+		APawn* Pawn = PC->GetPawn();
+		const FVector Location = Pawn->GetActorLocation() + Pawn->GetActorForwardVector() * 150.f + FVector(0.f, 0.f, 50.f);
+		const FRotator Rotation = (Pawn->GetActorLocation() - Location).GetSafeNormal2D().Rotation();
+		ShownMenu = Menu->ShowMenu(Menu->MenuWidgetClass.LoadSynchronous(), FTransform(Rotation, Location, FVector(0.2f)));
+	}));
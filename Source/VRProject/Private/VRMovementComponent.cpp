@@ -0,0 +1,259 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "VRMovementComponent.h"
+#include "VRPlayer.h"
+#include "VRGameModeBase.h"
+#include "VRProject.h"
+#include "Components/CapsuleComponent.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/PlayerController.h"
+
+DECLARE_CYCLE_STAT(TEXT("VR Lean Movement"), STAT_VR_LeanMovement, STATGROUP_VRProject);
+
+// 이동 방식별 측정값(0: CharacterMovement, 1: 가벼운 이동)
+static double GVRMovementTickSeconds[2] = {};
+static int64 GVRMovementTickCount[2] = {};
+
+void UVRMovementComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	// 시간 측정은 비교 벤치마크(Shipping 제외)와 서버의 플레이어 예산에만 쓰고, 그 밖에는 비용을 내지 않고 싶다.
+	// 원격 클라이언트의 폰은 Tick 대신 MoveAutonomous에서 움직이므로 거기서 기록한다.
+	const bool bRecordServerCost = PawnOwner && PawnOwner->GetRemoteRole() != ROLE_AutonomousProxy
+		&& GetWorld()->GetAuthGameMode<AVRGameModeBase>();
+	const bool bMeasure = !UE_BUILD_SHIPPING || bRecordServerCost;
+	const double StartTime = bMeasure ? FPlatformTime::Seconds() : 0.0;
+
+	if(bBenchmarkWander && PawnOwner)
+	{
+		const float Phase = GetWorld()->GetTimeSeconds() + PawnOwner->GetUniqueID() * 0.37f;
+		AddInputVector(FVector(FMath::Cos(Phase), FMath::Sin(Phase), 0.f));
+	}
+
+	const bool bLean = IsLeanMovementActive();
+	if(bLean)
+	{
+		// CharacterMovement의 Tick은 건너뛰고 기본 이동 컴포넌트 처리만 한다.
+		UPawnMovementComponent::TickComponent(DeltaTime, TickType, ThisTickFunction);
+		LeanMove(DeltaTime);
+	}
+	else
+	{
+		Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+	}
+
+	if(!bMeasure)
+	{
+		return;
+	}
+
+	const double Seconds = FPlatformTime::Seconds() - StartTime;
+#if !UE_BUILD_SHIPPING
+	GVRMovementTickSeconds[bLean ? 1 : 0] += Seconds;
+	GVRMovementTickCount[bLean ? 1 : 0]++;
+#endif
+	if(bRecordServerCost)
+	{
+		RecordServerCost(Seconds);
+	}
+}
+
+void UVRMovementComponent::MoveAutonomous(float ClientTimeStamp, float DeltaTime, uint8 CompressedFlags, const FVector& NewAccel)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	Super::MoveAutonomous(ClientTimeStamp, DeltaTime, CompressedFlags, NewAccel);
+	RecordServerCost(FPlatformTime::Seconds() - StartTime);
+}
+
+void UVRMovementComponent::RecordServerCost(double Seconds) const
+{
+	// 게임 모드는 서버에만 있다.
+	AVRGameModeBase* GameMode = GetWorld()->GetAuthGameMode<AVRGameModeBase>();
+	if(GameMode && PawnOwner)
+	{
+		GameMode->RecordPawnMovement(PawnOwner->GetController(), Seconds);
+	}
+}
+
+bool UVRMovementComponent::IsLeanMovementActive() const
+{
+	// 클라이언트가 조종하는 폰(서버 쪽 복사본 포함)과 클라이언트의 폰은 CharacterMovement의 네트워크 이동이 필요하다.
+	return bUseLeanMovement && PawnOwner
+		&& PawnOwner->GetLocalRole() == ROLE_Authority
+		&& PawnOwner->GetRemoteRole() != ROLE_AutonomousProxy;
+}
+
+void UVRMovementComponent::LeanMove(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_VR_LeanMovement);
+
+	const FVector Input = ConsumeInputVector().GetClampedToMaxSize(1.f);
+	if(ShouldSkipUpdate(DeltaTime) || UpdatedComponent == nullptr || PawnOwner == nullptr)
+	{
+		return;
+	}
+
+	// 텔레포트/워프 중에는 폰이 직접 위치를 옮긴다.
+	if(bTeleportSuspended)
+	{
+		Velocity = FVector::ZeroVector;
+		return;
+	}
+
+	// 1. 바닥(캐시)
+	const FVector Location = UpdatedComponent->GetComponentLocation();
+	FramesSinceFloorCheck++;
+	if(bFloorValid == false || FramesSinceFloorCheck >= FloorRecheckFrames || FVector::DistSquared2D(Location, FloorCheckLocation) > FMath::Square(FloorRecheckDistance))
+	{
+		UpdateFloor();
+	}
+
+	// 2. 속도: 수평은 입력, 수직은 바닥이 없을 때만 중력
+	Velocity.X = Input.X * MaxWalkSpeed;
+	Velocity.Y = Input.Y * MaxWalkSpeed;
+	Velocity.Z = bOnFloor ? 0.f : FMath::Max(Velocity.Z + GetGravityZ() * DeltaTime, -GetPhysicsVolume()->TerminalVelocity);
+
+	FVector Delta = Velocity * DeltaTime;
+	if(bOnFloor)
+	{
+		// 바닥 높이를 따라간다(계단 높이까지).
+		const float HalfHeight = CharacterOwner ? CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleHalfHeight() : 0.f;
+		Delta.Z = FMath::Clamp(FloorZ + HalfHeight - Location.Z, -MaxStepHeight, MaxStepHeight);
+	}
+
+	if(Delta.IsNearlyZero())
+	{
+		UpdateComponentVelocity();
+		return;
+	}
+
+	// 3. 쓸어서 이동하고 막히면 미끄러진다.
+	FHitResult Hit;
+	SafeMoveUpdatedComponent(Delta, UpdatedComponent->GetComponentQuat(), true, Hit);
+	if(Hit.IsValidBlockingHit())
+	{
+		// 떨어지다가 걸을 수 있는 면에 닿았다면 바닥을 다시 찾는다.
+		if(bOnFloor == false && IsWalkable(Hit))
+		{
+			bFloorValid = false;
+		}
+		UMovementComponent::SlideAlongSurface(Delta, 1.f - Hit.Time, Hit.Normal, Hit, true);
+	}
+
+	UpdateComponentVelocity();
+}
+
+void UVRMovementComponent::UpdateFloor()
+{
+	const FVector Location = UpdatedComponent->GetComponentLocation();
+	const float HalfHeight = CharacterOwner ? CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleHalfHeight() : 0.f;
+
+	// 캡슐 아래로 선 하나만 쏜다.
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(VRLeanFloor), false, PawnOwner);
+	FHitResult Hit;
+	const ECollisionChannel Channel = UpdatedPrimitive ? UpdatedPrimitive->GetCollisionObjectType() : ECC_Pawn;
+	CSV_CUSTOM_STAT(VRProject, SceneQueries, 1, ECsvCustomStatOp::Accumulate);
+	const bool bHit = GetWorld()->LineTraceSingleByChannel(Hit, Location, Location - FVector(0.f, 0.f, HalfHeight + FloorProbeDistance), Channel, Params);
+
+	bOnFloor = bHit && IsWalkable(Hit) && Velocity.Z <= 0.f;
+	FloorZ = bHit ? Hit.ImpactPoint.Z : 0.f;
+	FloorCheckLocation = Location;
+	FramesSinceFloorCheck = 0;
+	bFloorValid = true;
+}
+
+void UVRMovementComponent::SetTeleportSuspended(bool bSuspended)
+{
+	bTeleportSuspended = bSuspended;
+}
+
+void UVRMovementComponent::NotifyTeleported()
+{
+	bTeleportSuspended = false;
+	bFloorValid = false;
+	Velocity = FVector::ZeroVector;
+}
+
+void UVRMovementComponent::ReportTickTimes()
+{
+#if UE_BUILD_SHIPPING
+	UE_LOG(LogVRProject, Warning, TEXT("Movement tick times are not collected in Shipping builds."));
+#endif
+	const TCHAR* Names[2] = { TEXT("CharacterMovement"), TEXT("LeanMovement") };
+	for(int32 i = 0; i < 2; i++)
+	{
+		const double AverageMs = GVRMovementTickCount[i] > 0 ? GVRMovementTickSeconds[i] * 1000.0 / GVRMovementTickCount[i] : 0.0;
+		UE_LOG(LogVRProject, Display, TEXT("%-18s ticks=%8lld avg=%.4f ms/pawn"), Names[i], GVRMovementTickCount[i], AverageMs);
+	}
+}
+
+void UVRMovementComponent::ResetTickTimes()
+{
+	FMemory::Memzero(GVRMovementTickSeconds);
+	FMemory::Memzero(GVRMovementTickCount);
+}
+
+// 이동 비용 비교용 콘솔 명령
+// 예) -nullrhi -ExecCmds="vr.Movement.Benchmark 200 1, vr.Movement.ResetTimes" 후 일정 시간 뒤 vr.Movement.Report
+static FAutoConsoleCommandWithWorldAndArgs GVRMovementBenchmarkCmd(
+	TEXT("vr.Movement.Benchmark"),
+	TEXT("Spawns N wandering VR pawns using lean (1) or CharacterMovement (0). Usage: vr.Movement.Benchmark <Count> <Lean> [Spacing]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if(World == nullptr)
+		{
+			return;
+		}
+
+		const int32 Count = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 200;
+		const bool bLean = Args.Num() > 1 ? FCString::Atoi(*Args[1]) != 0 : true;
+		const float Spacing = Args.Num() > 2 ? FCString::Atof(*Args[2]) : 200.f;
+
+		// 게임 모드의 기본 폰(블루프린트) 클래스를 사용한다.
+		UClass* PawnClass = AVRPlayer::StaticClass();
+		if(AGameModeBase* GameMode = World->GetAuthGameMode())
+		{
+			if(GameMode->DefaultPawnClass && GameMode->DefaultPawnClass->IsChildOf(AVRPlayer::StaticClass()))
+			{
+				PawnClass = GameMode->DefaultPawnClass;
+			}
+		}
+
+		FVector Origin = FVector::ZeroVector;
+		if(APlayerController* PC = World->GetFirstPlayerController())
+		{
+			if(PC->GetPawn())
+			{
+				Origin = PC->GetPawn()->GetActorLocation();
+			}
+		}
+
+		FActorSpawnParameters Params;
+		Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+		const int32 Columns = FMath::Max(1, FMath::CeilToInt(FMath::Sqrt((float)Count)));
+		for(int32 i = 0; i < Count; i++)
+		{
+			const FVector Offset((i / Columns + 1) * Spacing, (i % Columns - Columns / 2) * Spacing, 0.f);
+			AVRPlayer* Pawn = World->SpawnActor<AVRPlayer>(PawnClass, Origin + Offset, FRotator::ZeroRotator, Params);
+			if(UVRMovementComponent* Movement = Pawn ? Cast<UVRMovementComponent>(Pawn->GetCharacterMovement()) : nullptr)
+			{
+				Movement->bUseLeanMovement = bLean;
+				Movement->bBenchmarkWander = true;
+				// 컨트롤러 없는 폰도 CharacterMovement가 이동하도록
+				Movement->bRunPhysicsWithNoController = true;
+			}
+		}
+
+		UE_LOG(LogVRProject, Display, TEXT("Spawned %d wandering VR pawns (%s)"), Count, bLean ? TEXT("lean") : TEXT("CharacterMovement"));
+	}));
+
+static FAutoConsoleCommand GVRMovementReportCmd(
+	TEXT("vr.Movement.Report"),
+	TEXT("Logs game-thread ms per pawn for CharacterMovement and lean VR movement."),
+	FConsoleCommandDelegate::CreateStatic(&UVRMovementComponent::ReportTickTimes));
+
+static FAutoConsoleCommand GVRMovementResetTimesCmd(
+	TEXT("vr.Movement.ResetTimes"),
+	TEXT("Clears the movement tick time measurements."),
+	FConsoleCommandDelegate::CreateStatic(&UVRMovementComponent::ResetTickTimes));
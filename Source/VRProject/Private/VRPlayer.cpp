@@ -12,9 +12,31 @@
 #include "NiagaraDataInterfaceArrayFunctionLibrary.h"
 #include "Components/WidgetInteractionComponent.h"
 #include "Haptics/HapticFeedbackEffect_Curve.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "VRProject.h"
+#include "VRHandAnimationSubsystem.h"
+#include "VRTeleportStreamingComponent.h"
+#include "VRHitchDetectorSubsystem.h"
+#include "VRHandTrackingComponent.h"
+#include "VRImpactAudioSubsystem.h"
+#include "VRActorPoolSubsystem.h"
+#include "VRPropFieldSubsystem.h"
+#include "VRPropActor.h"
+#include "VRMovementComponent.h"
+#include "VRMenuSubsystem.h"
+#include "VRSimulation.h"
+#include "VRGameModeBase.h"
+#include "VRRemoteProxySubsystem.h"
+#include "Net/UnrealNetwork.h"
+
+// 워프/원거리 잡기 타이머 간격(= 고정 시뮬레이션 시간 간격)
+static constexpr float WarpStepTime = 0.01f;
+static constexpr float RemotePullStepTime = 0.02f;
 
 // Sets default values
-AVRPlayer::AVRPlayer()
+AVRPlayer::AVRPlayer(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer.SetDefaultSubobjectClass<UVRMovementComponent>(ACharacter::CharacterMovementComponentName))
 {
  	// Set this character to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
 	PrimaryActorTick.bCanEverTick = true;
@@ -35,19 +57,12 @@ AVRPlayer::AVRPlayer()
 	RightHandMesh = CreateDefaultSubobject<USkeletalMeshComponent>(TEXT("Right Hand Mesh"));
 	RightHandMesh->SetupAttachment(RightHand);
 	
-	ConstructorHelpers::FObjectFinder<USkeletalMesh> TempLeftHandMesh(TEXT("/Script/Engine.SkeletalMesh'/Game/Characters/MannequinsXR/Meshes/SKM_MannyXR_left.SKM_MannyXR_left'"));
-	if(TempLeftHandMesh.Succeeded())
-	{
-		LeftHandMesh->SetSkeletalMesh(TempLeftHandMesh.Object);
-		LeftHandMesh->SetRelativeLocationAndRotation(FVector(-2.9f,-3.5f,4.5f), FRotator(-25.f,-180.f,90.f));
-	}
+	// 손 메시는 하드 로드하지 않고 경로만 기억해 두었다가 BeginPlay에서 비동기로 로드한다.
+	LeftHandMeshAsset = TSoftObjectPtr<USkeletalMesh>(FSoftObjectPath(TEXT("/Game/Characters/MannequinsXR/Meshes/SKM_MannyXR_left.SKM_MannyXR_left")));
+	LeftHandMesh->SetRelativeLocationAndRotation(FVector(-2.9f,-3.5f,4.5f), FRotator(-25.f,-180.f,90.f));
 
-	ConstructorHelpers::FObjectFinder<USkeletalMesh> TempRightHandMesh(TEXT("/Script/Engine.SkeletalMesh'/Game/Characters/MannequinsXR/Meshes/SKM_MannyXR_right.SKM_MannyXR_right'"));
-	if(TempRightHandMesh.Succeeded())
-	{
-		RightHandMesh->SetSkeletalMesh(TempRightHandMesh.Object);
-		RightHandMesh->SetRelativeLocationAndRotation(FVector(-2.9f,-3.5f,4.5f), FRotator(25.f,0.f,90.f));
-	}
+	RightHandMeshAsset = TSoftObjectPtr<USkeletalMesh>(FSoftObjectPath(TEXT("/Game/Characters/MannequinsXR/Meshes/SKM_MannyXR_right.SKM_MannyXR_right")));
+	RightHandMesh->SetRelativeLocationAndRotation(FVector(-2.9f,-3.5f,4.5f), FRotator(25.f,0.f,90.f));
 
 	// Teleport
 	TeleportCircle = CreateDefaultSubobject<UNiagaraComponent>(TEXT("Teleport Circle"));
@@ -58,6 +73,9 @@ AVRPlayer::AVRPlayer()
 	TeleportCurveTraceComponent = CreateDefaultSubobject<UNiagaraComponent>(TEXT("Teleport Curve Trace"));
 	TeleportCurveTraceComponent->SetupAttachment(RootComponent);
 
+	// Teleport Streaming
+	TeleportStreaming = CreateDefaultSubobject<UVRTeleportStreamingComponent>(TEXT("Teleport Streaming"));
+
 	// 집게손가락
 	RightAim = CreateDefaultSubobject<UMotionControllerComponent>(TEXT("RightAim"));
 	RightAim->SetupAttachment(RootComponent);
@@ -66,6 +84,9 @@ AVRPlayer::AVRPlayer()
 	// 위젯
 	WidgetInteractionComponent = CreateDefaultSubobject<UWidgetInteractionComponent>(TEXT("Widget Interaction Component"));
 	WidgetInteractionComponent->SetupAttachment(RightAim);
+
+	// 손 추적
+	HandTracking = CreateDefaultSubobject<UVRHandTrackingComponent>(TEXT("Hand Tracking"));
 }
 
 // Called when the game starts or when spawned
@@ -73,28 +94,26 @@ void AVRPlayer::BeginPlay()
 {
 	Super::BeginPlay();
 
-	// Enhanced Input 사용 처리
-	auto PlayerController = Cast<APlayerController>(GetWorld()->GetFirstPlayerController());
+	// 입력/손 메시 에셋 비동기 로드
+	// -> Enhanced Input 매핑과 크로스헤어는 로드가 끝나면 처리된다.
+	RequestAssetLoads();
 
-	if(PlayerController)
+	// 손 애니메이션 예산, 중요도 관리에 등록
+	RegisterWithWorldSystems();
+
+	// 가벼운 이동을 쓰는 폰은 MoveSpeed로 걷는다.
+	if(auto VRMovement = Cast<UVRMovementComponent>(GetCharacterMovement()))
 	{
-		// LocalPlayer
-		auto LocalPlayer = PlayerController->GetLocalPlayer();
-		auto Subsystem = ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(LocalPlayer);
-		if(Subsystem)
+		if(VRMovement->bUseLeanMovement)
 		{
-			Subsystem->AddMappingContext(IMC_VRInput, 0);
-			Subsystem->AddMappingContext(IMC_Hand, 0);
+			VRMovement->MaxWalkSpeed = MoveSpeed;
 		}
 	}
 
-	TeleportReset();
+	// 손 추적 제스처 연결
+	HandTracking->OnGesture.AddUObject(this, &AVRPlayer::OnHandGesture);
 
-	// 크로스헤어 객체 만들기
-	if(CrosshairFactory)
-	{
-		Crosshair = GetWorld()->SpawnActor<AActor>(CrosshairFactory);
-	}
+	TeleportReset();
 
 	// 만약 HMD가 연결되어 있지 않다면
 	if(UHeadMountedDisplayFunctionLibrary::IsHeadMountedDisplayEnabled() == false)
@@ -113,13 +132,32 @@ void AVRPlayer::BeginPlay()
 	}
 }
 
+void AVRPlayer::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UnregisterFromWorldSystems();
+
+	// 크로스헤어는 다음 폰이 재사용하도록 풀에 돌려놓는다.
+	if(auto ActorPool = GetWorld()->GetSubsystem<UVRActorPoolSubsystem>())
+	{
+		ActorPool->Release(Crosshair);
+	}
+	Crosshair = nullptr;
+
+	Super::EndPlay(EndPlayReason);
+}
+
 // Called every frame
 void AVRPlayer::Tick(float DeltaTime)
 {
+	VR_FEATURE_SCOPE(PawnTick);
+	const uint64 TickStartCycles = FPlatformTime::Cycles64();
+
 	Super::Tick(DeltaTime);
 
+	const bool bLocal = SignificanceTier == EVRSignificanceTier::Local;
+
 	// HMD가 연결되어 있지 않으면
-	if(UHeadMountedDisplayFunctionLibrary::IsHeadMountedDisplayEnabled() == false)
+	if(bLocal && UHeadMountedDisplayFunctionLibrary::IsHeadMountedDisplayEnabled() == false)
 	{
 		// 손이 카메라 방향과 일치하도록 한다.
 		RightHand->SetRelativeRotation(VRCamera->GetRelativeRotation());
@@ -127,8 +165,8 @@ void AVRPlayer::Tick(float DeltaTime)
 	}
 	
 	
-	// 텔레포트 확인 처리
-	if(bTeleporting)
+	// 텔레포트 확인 처리(원격 플레이어는 트레이스 하지 않는다)
+	if(bLocal && bTeleporting)
 	{
 		if(bTeleportCurve)
 		{
@@ -140,25 +178,106 @@ void AVRPlayer::Tick(float DeltaTime)
 			// 직선 텔레포트
 			TeleportDrawStraight();
 		}
+
+		// 조준 중인 목적지를 미리 스트리밍 한다.
+		if(TeleportCircle->GetVisibleFlag())
+		{
+			TeleportStreaming->SetPredictedDestination(TeleportPos);
+		}
+		else
+		{
+			TeleportStreaming->ClearPrediction();
+		}
 	}
 
 	CurrentNiagaraTime += DeltaTime;
 	if(CurrentNiagaraTime > NiagaraTime)
 	{
-		// 나이아가라를 이용해 선 그리기
-		if(TeleportCurveTraceComponent)
+		VR_FEATURE_SCOPE(TeleportBeam);
+
+		// 나이아가라를 이용해 선 그리기(원격 플레이어는 선이 보일 때만)
+		const bool bBeamVisible = bLocal || (SignificanceTier != EVRSignificanceTier::Culled && TeleportCurveTraceComponent && TeleportCurveTraceComponent->WasRecentlyRendered());
+		if(TeleportCurveTraceComponent && bBeamVisible)
 		{
 			UNiagaraDataInterfaceArrayFunctionLibrary::SetNiagaraArrayVector(TeleportCurveTraceComponent, FName("User.PointArray"), Vertices);
 		}
 		CurrentNiagaraTime = 0.f;
 	}
 
-	// Crosshair
-	DrawCrosshair();
-
 	Grabbing();
 
-	DrawDebugRemoteGrab();
+	// Crosshair, 원격 잡기 시각화는 로컬 플레이어만 트레이스 한다.
+	if(bLocal)
+	{
+		DrawCrosshair();
+		DrawDebugRemoteGrab();
+
+		// 위젯 상호작용 트레이스는 조준선이 위젯 근처에 있을 때만
+		if(auto Menu = GetWorld()->GetSubsystem<UVRMenuSubsystem>())
+		{
+			Menu->UpdateInteraction(WidgetInteractionComponent);
+		}
+	}
+
+	const double TickSeconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - TickStartCycles);
+	if(auto Significance = GetWorld()->GetSubsystem<UVRSignificanceSubsystem>())
+	{
+		Significance->RecordTickTime(SignificanceTier, TickSeconds);
+	}
+	// 머리/손 자세 복제
+	if(bLocal)
+	{
+		UpdateNetPose(DeltaTime);
+	}
+
+	// 플레이어별 예산 추적(서버, 중요도 단계와 상관없이 컨트롤러마다)
+	auto GameMode = GetWorld()->GetAuthGameMode<AVRGameModeBase>();
+	if(GameMode)
+	{
+		GameMode->RecordPawnTick(GetController(), TickSeconds);
+	}
+}
+
+void AVRPlayer::SetSignificanceTier(EVRSignificanceTier NewTier)
+{
+	if(SignificanceTier == NewTier)
+	{
+		return;
+	}
+	SignificanceTier = NewTier;
+
+	// 단계에 따라 Tick 주기를 줄인다.
+	switch(NewTier)
+	{
+	case EVRSignificanceTier::Local:
+		SetActorTickInterval(0.f);
+		break;
+	case EVRSignificanceTier::NearRemote:
+		SetActorTickInterval(NearRemoteTickInterval);
+		break;
+	case EVRSignificanceTier::FarRemote:
+		SetActorTickInterval(FarRemoteTickInterval);
+		break;
+	default:
+		SetActorTickInterval(CulledTickInterval);
+		break;
+	}
+
+	// 크로스헤어는 로컬 플레이어만 보여준다.
+	if(Crosshair)
+	{
+		Crosshair->SetActorHiddenInGame(NewTier != EVRSignificanceTier::Local);
+	}
+
+	// 원격 플레이어는 위젯과 상호작용하지 않는다.
+	if(NewTier != EVRSignificanceTier::Local && WidgetInteractionComponent)
+	{
+		WidgetInteractionComponent->SetComponentTickEnabled(false);
+	}
+
+	// 멀리 있거나 보이지 않는 원격 플레이어는 프록시로 그린다(데디케이티드 서버는 그리지 않는다).
+	const bool bFar = NewTier == EVRSignificanceTier::FarRemote || NewTier == EVRSignificanceTier::Culled;
+	SetProxyMode(bFar && GetNetMode() != NM_DedicatedServer);
 }
 
 // Called to bind functionality to input
@@ -166,26 +285,245 @@ void AVRPlayer::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
 {
 	Super::SetupPlayerInputComponent(PlayerInputComponent);
 
-	auto InputSystem = CastChecked<UEnhancedInputComponent>(PlayerInputComponent);
+	// 새 InputComponent이므로 바인딩을 다시 해야 한다.
+	bInputActionsBound = false;
+
+	// 빙의가 BeginPlay보다 먼저 일어날 수도 있으니 여기서도 로드를 요청한다.
+	RequestAssetLoads();
+
+	// 입력 에셋이 아직 로드 중이라면 로드 완료 후에 바인딩한다.
+	if(bInputAssetsReady)
+	{
+		BindInputActions(CastChecked<UEnhancedInputComponent>(PlayerInputComponent));
+	}
+}
+
+void AVRPlayer::RequestAssetLoads()
+{
+	// 이미 요청했다면 다시 요청하지 않는다.
+	if(InputAssetsHandle.IsValid())
+	{
+		return;
+	}
+
+	AssetLoadStartTime = FPlatformTime::Seconds();
+	FStreamableManager& Streamable = UAssetManager::GetStreamableManager();
+
+	// 1. 입력/상호작용 번들: 조작에 필요한 에셋이므로 높은 우선순위로 먼저 받는다.
+	TArray<FSoftObjectPath> InputAssets;
+	for(const FSoftObjectPath& Path : {
+		IMC_VRInput.ToSoftObjectPath(), IMC_Hand.ToSoftObjectPath(),
+		IA_VRMove.ToSoftObjectPath(), IA_VRLook.ToSoftObjectPath(), IA_Teleport.ToSoftObjectPath(),
+		IA_Fire.ToSoftObjectPath(), IA_Grab.ToSoftObjectPath(),
+		HF_Fire.ToSoftObjectPath(), CrosshairFactory.ToSoftObjectPath(), ImpactMarkerFactory.ToSoftObjectPath() })
+	{
+		if(Path.IsValid())
+		{
+			InputAssets.Add(Path);
+		}
+	}
+	InputAssetsHandle = Streamable.RequestAsyncLoad(InputAssets, FStreamableDelegate::CreateUObject(this, &AVRPlayer::OnInputAssetsLoaded), FStreamableManager::AsyncLoadHighPriority);
+
+	// 2. 손 메시 번들: 로드가 끝나는 대로 보이게 한다.
+	TArray<FSoftObjectPath> MeshAssets;
+	if(LeftHandMeshAsset.ToSoftObjectPath().IsValid())
+	{
+		MeshAssets.Add(LeftHandMeshAsset.ToSoftObjectPath());
+	}
+	if(RightHandMeshAsset.ToSoftObjectPath().IsValid())
+	{
+		MeshAssets.Add(RightHandMeshAsset.ToSoftObjectPath());
+	}
+	HandMeshAssetsHandle = Streamable.RequestAsyncLoad(MeshAssets, FStreamableDelegate::CreateUObject(this, &AVRPlayer::OnHandMeshesLoaded));
+
+	// 요청할 에셋이 없으면 핸들이 만들어지지 않으므로 직접 처리한다.
+	// 입력은 이미 메모리에 있을 경우 다음 프레임까지 기다리지 않고 바로 처리한다.
+	if(InputAssetsHandle.IsValid() == false || InputAssetsHandle->HasLoadCompleted())
+	{
+		OnInputAssetsLoaded();
+	}
+	if(HandMeshAssetsHandle.IsValid() == false)
+	{
+		OnHandMeshesLoaded();
+	}
+}
+
+void AVRPlayer::OnInputAssetsLoaded()
+{
+	// 중복 호출 방지
+	if(bInputAssetsReady)
+	{
+		return;
+	}
+	bInputAssetsReady = true;
+
+	UE_LOG(LogVRProject, Log, TEXT("%s: input assets ready in %.2f ms"), *GetName(), (FPlatformTime::Seconds() - AssetLoadStartTime) * 1000.0);
+
+	AddInputMappingContexts();
+
+	// 이미 InputComponent가 만들어져 있다면 바로 바인딩한다.
+	if(InputComponent)
+	{
+		BindInputActions(CastChecked<UEnhancedInputComponent>(InputComponent));
+	}
+
+	// 크로스헤어 객체 만들기
+	AcquireCrosshair();
+}
+
+void AVRPlayer::AcquireCrosshair()
+{
+	// 크로스헤어는 액터 풀에서 꺼낸다.
+	if(UClass* CrosshairClass = CrosshairFactory.Get())
+	{
+		auto ActorPool = GetWorld() ? GetWorld()->GetSubsystem<UVRActorPoolSubsystem>() : nullptr;
+		if(Crosshair == nullptr && ActorPool)
+		{
+			Crosshair = ActorPool->Acquire(CrosshairClass, GetActorTransform());
+			if(Crosshair)
+			{
+				Crosshair->SetActorHiddenInGame(SignificanceTier != EVRSignificanceTier::Local);
+			}
+		}
+	}
+}
+
+void AVRPlayer::OnHandMeshesLoaded()
+{
+	UE_LOG(LogVRProject, Log, TEXT("%s: hand meshes ready in %.2f ms"), *GetName(), (FPlatformTime::Seconds() - AssetLoadStartTime) * 1000.0);
 
-	if(InputSystem)
+	if(USkeletalMesh* LeftMesh = LeftHandMeshAsset.Get())
+	{
+		LeftHandMesh->SetSkeletalMesh(LeftMesh);
+	}
+	if(USkeletalMesh* RightMesh = RightHandMeshAsset.Get())
 	{
-		// Binding
-		InputSystem->BindAction(IA_VRMove, ETriggerEvent::Triggered, this, &AVRPlayer::Move);
-		InputSystem->BindAction(IA_VRLook, ETriggerEvent::Triggered, this, &AVRPlayer::Look);
+		RightHandMesh->SetSkeletalMesh(RightMesh);
+	}
+}
+
+void AVRPlayer::BindInputActions(UEnhancedInputComponent* InputSystem)
+{
+	if(InputSystem == nullptr || bInputActionsBound)
+	{
+		return;
+	}
+	bInputActionsBound = true;
+
+	// Binding
+	InputSystem->BindAction(IA_VRMove.Get(), ETriggerEvent::Triggered, this, &AVRPlayer::Move);
+	InputSystem->BindAction(IA_VRLook.Get(), ETriggerEvent::Triggered, this, &AVRPlayer::Look);
+
+	InputSystem->BindAction(IA_Teleport.Get(), ETriggerEvent::Started, this, &AVRPlayer::TeleportStart);
+	InputSystem->BindAction(IA_Teleport.Get(), ETriggerEvent::Completed, this, &AVRPlayer::TeleportEnd);
+
+	InputSystem->BindAction(IA_Fire.Get(), ETriggerEvent::Started, this, &AVRPlayer::FireInput);
 
-		InputSystem->BindAction(IA_Teleport, ETriggerEvent::Started, this, &AVRPlayer::TeleportStart);
-		InputSystem->BindAction(IA_Teleport, ETriggerEvent::Completed, this, &AVRPlayer::TeleportEnd);
+	InputSystem->BindAction(IA_Grab.Get(), ETriggerEvent::Started, this, &AVRPlayer::TryGrab);
+	InputSystem->BindAction(IA_Grab.Get(), ETriggerEvent::Completed, this, &AVRPlayer::TryUnGrab);
+}
 
-		InputSystem->BindAction(IA_Fire, ETriggerEvent::Started, this, &AVRPlayer::FireInput);
+void AVRPlayer::InjectInputAction(const UInputAction* Action, ETriggerEvent TriggerEvent, const FInputActionValue& Value)
+{
+	if(Action == nullptr)
+	{
+		return;
+	}
 
-		InputSystem->BindAction(IA_Grab, ETriggerEvent::Started, this, &AVRPlayer::TryGrab);
-		InputSystem->BindAction(IA_Grab, ETriggerEvent::Completed, this, &AVRPlayer::TryUnGrab);
+	// BindInputActions와 같은 연결
+	if(Action == IA_VRMove.Get() && TriggerEvent == ETriggerEvent::Triggered)
+	{
+		Move(Value);
+	}
+	else if(Action == IA_VRLook.Get() && TriggerEvent == ETriggerEvent::Triggered)
+	{
+		Look(Value);
+	}
+	else if(Action == IA_Teleport.Get() && TriggerEvent == ETriggerEvent::Started)
+	{
+		TeleportStart(Value);
+	}
+	else if(Action == IA_Teleport.Get() && TriggerEvent == ETriggerEvent::Completed)
+	{
+		TeleportEnd(Value);
+	}
+	else if(Action == IA_Fire.Get() && TriggerEvent == ETriggerEvent::Started)
+	{
+		FireInput(Value);
+	}
+	else if(Action == IA_Grab.Get() && TriggerEvent == ETriggerEvent::Started)
+	{
+		TryGrab();
+	}
+	else if(Action == IA_Grab.Get() && TriggerEvent == ETriggerEvent::Completed)
+	{
+		TryUnGrab();
+	}
+}
+
+void AVRPlayer::OnHandGesture(EControllerHand Hand, EVRGesture Gesture, bool bStarted)
+{
+	// 오른손만 상호작용에 사용한다.
+	if(Hand != EControllerHand::Right)
+	{
+		return;
+	}
+
+	// 주먹 쥐기 = 잡기 버튼
+	if(Gesture == EVRGesture::Grab)
+	{
+		if(bStarted)
+		{
+			TryGrab();
+		}
+		else
+		{
+			TryUnGrab();
+		}
+	}
+	// 집기 = 총쏘기 버튼
+	else if(Gesture == EVRGesture::Pinch && bStarted)
+	{
+		FireInput(FInputActionValue(true));
+	}
+}
+
+void AVRPlayer::SetTrackingPose(const FTransform& Head, const FTransform& Left, const FTransform& Right)
+{
+	VRCamera->SetRelativeTransform(Head);
+	LeftHand->SetRelativeTransform(Left);
+	RightHand->SetRelativeTransform(Right);
+	RightAim->SetRelativeTransform(Right);
+}
+
+void AVRPlayer::AddInputMappingContexts()
+{
+	// Enhanced Input 사용 처리
+	auto PlayerController = Cast<APlayerController>(GetWorld()->GetFirstPlayerController());
+
+	if(PlayerController)
+	{
+		// LocalPlayer
+		auto LocalPlayer = PlayerController->GetLocalPlayer();
+		auto Subsystem = ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(LocalPlayer);
+		if(Subsystem)
+		{
+			if(IMC_VRInput.Get())
+			{
+				Subsystem->AddMappingContext(IMC_VRInput.Get(), 0);
+			}
+			if(IMC_Hand.Get())
+			{
+				Subsystem->AddMappingContext(IMC_Hand.Get(), 0);
+			}
+		}
 	}
 }
 
 void AVRPlayer::Move(const FInputActionValue& Value)
 {
+	VR_FEATURE_SCOPE(Input);
+
 	// 1. 사용자의 입력에 따라 이동한다.
 	FVector2D Axis = Value.Get<FVector2D>();
 	AddMovementInput(GetActorForwardVector(), Axis.X);
@@ -204,6 +542,8 @@ void AVRPlayer::Move(const FInputActionValue& Value)
 
 void AVRPlayer::Look(const FInputActionValue& Value)
 {
+	VR_FEATURE_SCOPE(Input);
+
 	FVector2D Axis = Value.Get<FVector2D>();
 	AddControllerPitchInput(-1 * Axis.Y);
 	AddControllerYawInput(Axis.X);
@@ -212,6 +552,8 @@ void AVRPlayer::Look(const FInputActionValue& Value)
 // 텔레포트 기능 활성화 처리
 void AVRPlayer::TeleportStart(const FInputActionValue& Value)
 {
+	VR_FEATURE_SCOPE(Input);
+
 	// 1. 텔레포트 이동
 	// 2. 텔레포트 목적지
 	// 3. 사용자가 그 지점을 가리킨다
@@ -226,11 +568,14 @@ void AVRPlayer::TeleportStart(const FInputActionValue& Value)
 
 void AVRPlayer::TeleportEnd(const FInputActionValue& Value)
 {
+	VR_FEATURE_SCOPE(Input);
+
 	// 텔레포트 기능 리셋
 	bTeleporting = false;
 	// 만약 텔레포트가 불가능하다면 
 	if(!TeleportReset())
 	{
+		TeleportStreaming->ClearPrediction();
 		// 다음 처리를 하지 않는다.
 		return;
 	}
@@ -246,6 +591,11 @@ void AVRPlayer::TeleportEnd(const FInputActionValue& Value)
 	{
 		// 텔레포트 위치로 이동하고 싶다.
 		SetActorLocation(TeleportPos + FVector::UpVector * GetCapsuleComponent()->GetScaledCapsuleHalfHeight());
+		TeleportStreaming->NotifyArrived();
+		if(auto VRMovement = Cast<UVRMovementComponent>(GetCharacterMovement()))
+		{
+			VRMovement->NotifyTeleported();
+		}
 	}
 }
 
@@ -263,13 +613,21 @@ bool AVRPlayer::TeleportReset()
 
 void AVRPlayer::TeleportDrawStraight()
 {
-	Vertices.RemoveAt(0, Vertices.Num());
-	
+	VR_FEATURE_SCOPE(TeleportAim);
+
 	// 직선을 그리고 싶다.
 	// 필요정보: 시작점, 종료점
 	FVector StartPos = RightAim->GetComponentLocation();
 	FVector EndPos = StartPos + RightAim->GetForwardVector() * 1000.f;
 
+	// 묶음 처리 중이면 충돌 확인과 Vertices 갱신은 조준 질의 결과에서 한다.
+	const FVector Points[] = { StartPos, EndPos };
+	if(SubmitAimQuery(EVRAimQuery::TeleportArc, Points, 0.f, ECC_Teleport))
+	{
+		return;
+	}
+
+	Vertices.RemoveAt(0, Vertices.Num());
 	// 두 점 사이에 충돌체가 있는지 확인한다.
 	CheckHitTeleport(StartPos, EndPos);
 	Vertices.Add(StartPos);
@@ -282,9 +640,16 @@ void AVRPlayer::TeleportDrawStraight()
 bool AVRPlayer::CheckHitTeleport(FVector LastPos, FVector& CurrentPos)
 {
 	FHitResult HitInfo;
-	bool bHit = HitTest(LastPos, CurrentPos, HitInfo);
-	// 만약 충돌한 대상이 바닥이라면
-	if(bHit && HitInfo.GetActor()->GetName().Contains(TEXT("Floor")))
+	bool bHit = HitTest(LastPos, CurrentPos, HitInfo, ECC_Teleport);
+	ApplyTeleportHit(bHit, HitInfo, CurrentPos);
+
+	return bHit;
+}
+
+void AVRPlayer::ApplyTeleportHit(bool bHit, const FHitResult& HitInfo, FVector& CurrentPos)
+{
+	// 만약 충돌한 대상이 바닥이라면(벽도 곡선을 막으므로 바닥 프로필인지 확인한다)
+	if(bHit && HitInfo.GetComponent() && HitInfo.GetComponent()->GetCollisionProfileName() == FName(VR_PROFILE_TeleportFloor))
 	{
 		// 마지막 점(EndPos)을 최종점으로 수정하고 싶다.
 		CurrentPos = HitInfo.Location;
@@ -298,18 +663,16 @@ bool AVRPlayer::CheckHitTeleport(FVector LastPos, FVector& CurrentPos)
 	{
 		TeleportCircle->SetVisibility(false);
 	}
-
-	return bHit;
 }
 
-bool AVRPlayer::HitTest(FVector LastPos, FVector CurrentPos, FHitResult& HitInfo)
+bool AVRPlayer::HitTest(FVector LastPos, FVector CurrentPos, FHitResult& HitInfo, ECollisionChannel TraceChannel)
 {
 	// 충돌에서 자기 자신은 무시한다.
-	FCollisionQueryParams Params;
-	Params.AddIgnoredActor(this);
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(VRHitTest), false, this);
 	
 	// 충돌 여부 확인
-	bool bHit = GetWorld()->LineTraceSingleByChannel(HitInfo, LastPos, CurrentPos, ECollisionChannel::ECC_Visibility, Params);
+	CSV_CUSTOM_STAT(VRProject, SceneQueries, 1, ECsvCustomStatOp::Accumulate);
+	bool bHit = GetWorld()->LineTraceSingleByChannel(HitInfo, LastPos, CurrentPos, TraceChannel, Params);
 
 	return bHit;
 }
@@ -317,35 +680,30 @@ bool AVRPlayer::HitTest(FVector LastPos, FVector CurrentPos, FHitResult& HitInfo
 // 주어진 속도로 투사체를 날려보내고, 투사체의 지나간 점을 기록한다.
 void AVRPlayer::TeleportDrawCurve()
 {
+	VR_FEATURE_SCOPE(TeleportAim);
+
+	// 1. 시작점, 방향, 세기를 가지고 곡선의 점들을 계산한다.
+	FVRSimulation::SimulateArc(RightAim->GetComponentLocation(), RightAim->GetForwardVector() * CurvedPower, Gravity, SimulatedTime, VertexCount, PendingVertices);
+
+	// 묶음 처리 중이면 곡선 전체를 하나의 질의로 요청하고, 자른 곡선은 결과에서 Vertices에 넣는다.
+	// (Vertices는 빔을 그릴 때 쓰므로 자르기 전 곡선으로 덮어쓰지 않는다.)
+	if(SubmitAimQuery(EVRAimQuery::TeleportArc, PendingVertices, 0.f, ECC_Teleport))
+	{
+		return;
+	}
+
 	// Vertices 초기화
-	Vertices.RemoveAt(0, Vertices.Num());
-	
-	// 1. 시작점, 방향, 세기를 가지고 
-	FVector CurvePos = RightAim->GetComponentLocation();
-	FVector Dir = RightAim->GetForwardVector() * CurvedPower;
-
-	Vertices.Add(CurvePos);
-	for(int i = 0; i < VertexCount-1; i++)
-	{
-		// 이전 점 기억
-		FVector LastCurvePos = CurvePos;
-		// 1. 투사체가 이동했으니까 반복적으로
-		// v = v0 + at
-		Dir += FVector::UpVector * Gravity * SimulatedTime;
-		// P = P0 + vt
-		CurvePos += Dir * SimulatedTime;
-		// 2. 투사체의 위치에서
-		// 만약 점과 점 사이에 물체가 가로막고 있다면
-		if(CheckHitTeleport(LastCurvePos, CurvePos))
+	Vertices = PendingVertices;
+
+	for(int32 i = 1; i < Vertices.Num(); i++)
+	{
+		// 2. 만약 점과 점 사이에 물체가 가로막고 있다면
+		if(CheckHitTeleport(Vertices[i - 1], Vertices[i]))
 		{
 			// 그 점을 마지막 점으로 한다.
-			Vertices.Add(CurvePos);
+			Vertices.SetNum(i + 1);
 			break;
 		}
-		
-		
-		// 3. 점을 기록한다.
-		Vertices.Add(CurvePos);
 	}
 
 	// for(int i = 0; i < Vertices.Num()-1; i++)
@@ -369,6 +727,15 @@ void AVRPlayer::DoWarp()
 
 	// 경과 시간 초기화
 	CurrentTime = 0.f;
+	// 시작 위치에서 목적지까지 경과 시간 비율로 이동한다.
+	WarpStartPos = GetActorLocation();
+	// 워프 중에는 이동 컴포넌트가 위치를 건드리지 않는다.
+	if(auto VRMovement = Cast<UVRMovementComponent>(GetCharacterMovement()))
+	{
+		VRMovement->SetTeleportSuspended(true);
+	}
+	// CharacterMovement도 워프 중(스트리밍 대기 포함)에는 중력/바닥 처리를 하지 않는다.
+	GetCharacterMovement()->DisableMovement();
 	// 충돌체 비활성화
 	GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 	// 1. 시간이 흘러야 한다.
@@ -377,16 +744,19 @@ void AVRPlayer::DoWarp()
 	// Lambda: [캡처](parameter)->returnType{body}, 캡처 안에 변수/함수를 모두 사용 가능
 	GetWorld()->GetTimerManager().SetTimer(WarpHandle, FTimerDelegate::CreateLambda([this]()->void
 	{
+		VR_FEATURE_SCOPE(Warp);
+
 		// function body
 		//일정 시간 안에 목적지에 도착하고 싶다.
 		// 1. 시간이 흘러야 한다.
-		CurrentTime += GetWorld()->DeltaTimeSeconds;
-		// 현재 위치
-		FVector CurrentPos = GetActorLocation();
+		CurrentTime += WarpStepTime;
 		// 도착 위치
 		FVector EndPos = TeleportPos + FVector::UpVector * GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+		// 목적지가 아직 로드되지 않았다면 도착 직전에서 기다린다(최대 MaxWarpStreamingWait 초).
+		const bool bDestinationReady = TeleportStreaming->IsDestinationStreamed() || CurrentTime >= WarpTime + TeleportStreaming->MaxWarpStreamingWait;
 		// 2. 이동해야 한다.
-		CurrentPos = FMath::Lerp<FVector>(CurrentPos, EndPos, CurrentTime / WarpTime);
+		// (현재 위치에서 보간하면 멈춰야 할 진행률에서도 몇 번 만에 목적지에 닿는다.)
+		const FVector CurrentPos = FVRSimulation::StepWarp(WarpStartPos, EndPos, CurrentTime, WarpTime, TeleportStreaming->WarpStreamingHoldAlpha, bDestinationReady);
 		
 		// // 3. 목적지에 도착
 		// // 거리가 거의 가까워졌다면 그 위치로 할당한다.
@@ -402,20 +772,34 @@ void AVRPlayer::DoWarp()
 		// 3. 목적지에 도착
 		SetActorLocation(CurrentPos);
 		// 시간이 다 흘렀다면
-		if(CurrentTime >= WarpTime)
+		if(CurrentTime >= WarpTime && bDestinationReady)
 		{
 			// -> 그 위치로 할당하고
 			SetActorLocation(EndPos);
+			TeleportStreaming->NotifyArrived();
+			// -> 이동과 충돌체를 다시 켜고
+			FinishWarp();
 			// -> 타이머 종료해주기
 			GetWorld()->GetTimerManager().ClearTimer(WarpHandle);
 		}
-	}), 0.01f, true);
+	}), WarpStepTime, true);
+}
+
+void AVRPlayer::FinishWarp()
+{
 	// 충돌체 활성화
 	GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+	GetCharacterMovement()->SetDefaultMovementMode();
+	if(auto VRMovement = Cast<UVRMovementComponent>(GetCharacterMovement()))
+	{
+		VRMovement->NotifyTeleported();
+	}
 }
 
 void AVRPlayer::FireInput(const FInputActionValue& Value)
 {
+	VR_FEATURE_SCOPE(Fire);
+
 	// UI에 이벤트를 전달하고 싶다.
 	if(WidgetInteractionComponent)
 	{
@@ -426,7 +810,7 @@ void AVRPlayer::FireInput(const FInputActionValue& Value)
 	auto PC = Cast<APlayerController>(GetController());
 	if(PC)
 	{
-		PC->PlayHapticEffect(HF_Fire, EControllerHand::Right);
+		PC->PlayHapticEffect(HF_Fire.Get(), EControllerHand::Right);
 	}
 	
 	// LineTrace를 이용해서 총을 쏘고 싶다.
@@ -436,15 +820,30 @@ void AVRPlayer::FireInput(const FInputActionValue& Value)
 	FVector EndPos = StartPos + RightAim->GetForwardVector() * 100000.f;
 	// 총쏘기(LineTrace 동작)
 	FHitResult HitInfo;
-	bool bHit = HitTest(StartPos, EndPos, HitInfo);
+	bool bHit = HitTest(StartPos, EndPos, HitInfo, ECC_Hitscan);
 	// 만약 부딪힌 대상이 있으면 
 	if(bHit)
 	{
+		// 맞은 곳 표시(플레이어별 예산 안에서)
+		if(UClass* ImpactMarkerClass = ImpactMarkerFactory.Get())
+		{
+			auto ActorPool = GetWorld()->GetSubsystem<UVRActorPoolSubsystem>();
+			if(ActorPool && TryUseImpactMarker())
+			{
+				ActorPool->AcquireForDuration(ImpactMarkerClass, FTransform(HitInfo.ImpactNormal.Rotation(), HitInfo.Location), ImpactMarkerLifetime);
+			}
+		}
+
 		auto HitComp = HitInfo.GetComponent();
 		if(HitComp && HitComp->IsSimulatingPhysics())
 		{
 			// 대상을 날려보낸다.
 			HitComp->AddForceAtLocation((EndPos - StartPos).GetSafeNormal() * HitComp->GetMass() * 100000.f, HitInfo.Location);
+			// 날아간 물체의 충돌음
+			if(auto ImpactAudio = GetWorld()->GetSubsystem<UVRImpactAudioSubsystem>())
+			{
+				ImpactAudio->TrackBody(HitComp);
+			}
 		}
 	}
 }
@@ -452,16 +851,42 @@ void AVRPlayer::FireInput(const FInputActionValue& Value)
 // 거리에 따라서 크로스헤어 크기가 같게 보이도록 한다.
 void AVRPlayer::DrawCrosshair()
 {
+	VR_FEATURE_SCOPE(Crosshair);
+
+	// 크로스헤어가 아직 로드되지 않았다면 그리지 않는다.
+	if(Crosshair == nullptr)
+	{
+		return;
+	}
+
 	// 시작점
 	FVector StartPos = RightAim->GetComponentLocation();
 	// 끝점
 	FVector EndPos = StartPos + RightAim->GetForwardVector() * 10000.f;
-	// 거리 저장
-	float Distance = 0.f;
+
+	// 묶음 처리 중이면 요청만 하고 결과에서 그린다.
+	const FVector Points[] = { StartPos, EndPos };
+	if(SubmitAimQuery(EVRAimQuery::Crosshair, Points, 0.f, ECC_Hitscan))
+	{
+		return;
+	}
+
 	// 충돌 정보를 저장
 	FHitResult HitInfo;
 	// 충돌 체크
-	bool bHit = HitTest(StartPos, EndPos, HitInfo);
+	bool bHit = HitTest(StartPos, EndPos, HitInfo, ECC_Hitscan);
+	ApplyCrosshair(bHit, HitInfo, StartPos, EndPos);
+}
+
+void AVRPlayer::ApplyCrosshair(bool bHit, const FHitResult& HitInfo, const FVector& StartPos, const FVector& EndPos)
+{
+	if(Crosshair == nullptr)
+	{
+		return;
+	}
+
+	// 거리 저장
+	float Distance = 0.f;
 	// 충돌이 발생하면
 	if(bHit)
 	{
@@ -487,6 +912,8 @@ void AVRPlayer::DrawCrosshair()
 
 void AVRPlayer::TryGrab()
 {
+	VR_FEATURE_SCOPE(Grab);
+
 	// 원거리 잡기가 활성화 되어 있으면
 	if(bIsRemoteGrab)
 	{
@@ -502,11 +929,16 @@ void AVRPlayer::TryGrab()
 	// 충돌한 물체들을 기록할 배열
 	TArray<FOverlapResult> HitObjs;
 	// 충돌 질의 작성
-	FCollisionQueryParams Params;
-	Params.AddIgnoredActor(this);
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(VRTryGrab), false, this);
 	Params.AddIgnoredComponent(RightHand);
+	// 인스턴스 소품은 잡기 범위 안의 것만 물리 액터로 승격해서 같이 검사한다.
+	if(auto PropField = GetWorld()->GetSubsystem<UVRPropFieldSubsystem>())
+	{
+		PropField->PromoteNearest(CenterPoint, GrabRange);
+	}
 	// 충돌 체크(구 충돌)
-	bool bHit = GetWorld()->OverlapMultiByChannel(HitObjs, CenterPoint, FQuat::Identity, ECC_Visibility, FCollisionShape::MakeSphere(GrabRange), Params);
+	CSV_CUSTOM_STAT(VRProject, SceneQueries, 1, ECsvCustomStatOp::Accumulate);
+	bool bHit = GetWorld()->OverlapMultiByChannel(HitObjs, CenterPoint, FQuat::Identity, ECC_Grabbable, FCollisionShape::MakeSphere(GrabRange), Params);
 
 	// 만약 충돌하지 않았다면
 	if(bHit == false)
@@ -522,7 +954,8 @@ void AVRPlayer::TryGrab()
 		// 1. 물리 기능이 활성화 되어 있는지 물체들 중에서
 		// -> 만약 부딪힌 컴포넌트가 물리기능이 비활성화 되어 있다면
 		// -> 검출하고 싶지 않다.
-		if(HitObjs[i].GetComponent()->IsSimulatingPhysics() == false)
+		// -> 승격된 소품은 잡기 전까지 물리가 꺼져 있으므로 예외
+		if(HitObjs[i].GetComponent()->IsSimulatingPhysics() == false && HitObjs[i].GetActor()->IsA<AVRPropActor>() == false)
 		{
 			continue;
 		}
@@ -558,6 +991,8 @@ void AVRPlayer::TryGrab()
 
 void AVRPlayer::TryUnGrab()
 {
+	VR_FEATURE_SCOPE(Grab);
+
 	// 만약 잡고있는 물체가 없다면
 	if(bIsGrabbed == false)
 	{
@@ -578,20 +1013,24 @@ void AVRPlayer::TryUnGrab()
 	GrabbedObject->AddForce(ThrowDirection * ThrowPower * GrabbedObject->GetMass());
 
 	// 회전 시키기
-	// 각속도 = (1 / dt) * dTheta(특정 축 기준 변위 각도 Axis, Angle)
-	float Angle;
-	FVector Axis;
-	float dt = GetWorld()->DeltaTimeSeconds;
-	DeltaRotation.ToAxisAndAngle(Axis, Angle);
-	FVector AngularVelocity = (1 / dt) * Angle * Axis;
+	// 각속도 = (1 / dt) * dTheta(마지막 프레임의 회전 변화량)
+	FVector AngularVelocity = FVRSimulation::ThrowAngularVelocity(DeltaRotation, GetWorld()->DeltaTimeSeconds);
 	GrabbedObject->SetPhysicsAngularVelocityInRadians(AngularVelocity * ToquePower, true);
 
+	// 던진 물체의 충돌음
+	if(auto ImpactAudio = GetWorld()->GetSubsystem<UVRImpactAudioSubsystem>())
+	{
+		ImpactAudio->TrackBody(GrabbedObject);
+	}
+
 	GrabbedObject = nullptr;
 }
 
 // 던질 때 필요한 정보를 업데이트 하기 위한 기능
 void AVRPlayer::Grabbing()
 {
+	VR_FEATURE_SCOPE(Grabbing);
+
 	if(bIsGrabbed == false)
 	{
 		return;
@@ -625,15 +1064,20 @@ void AVRPlayer::RemoteGrab()
 	// 충돌한 물체들을 기록할 배열
 	TArray<FOverlapResult> HitObjs;
 	// 충돌 질의 작성
-	FCollisionQueryParams Params;
-	Params.AddIgnoredActor(this);
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(VRRemoteGrab), false, this);
 	Params.AddIgnoredComponent(RightAim);
+	// 인스턴스 소품은 쓸어가는 경로에서 처음 닿는 것만 물리 액터로 승격한다.
+	if(auto PropField = GetWorld()->GetSubsystem<UVRPropFieldSubsystem>())
+	{
+		PropField->PromoteAlongSweep(CenterPoint, EndPos, RemoteRadius);
+	}
 
 	FHitResult HitInfo;
-	bool bHit = GetWorld()->SweepSingleByChannel(HitInfo, CenterPoint, EndPos, FQuat::Identity, ECC_Visibility, FCollisionShape::MakeSphere(RemoteRadius), Params);
+	CSV_CUSTOM_STAT(VRProject, SceneQueries, 1, ECsvCustomStatOp::Accumulate);
+	bool bHit = GetWorld()->SweepSingleByChannel(HitInfo, CenterPoint, EndPos, FQuat::Identity, ECC_Grabbable, FCollisionShape::MakeSphere(RemoteRadius), Params);
 
 	// 충돌이 됐으면 잡아당기기 애니메이션 실행
-	if(bHit && HitInfo.GetComponent()->IsSimulatingPhysics())
+	if(bHit && (HitInfo.GetComponent()->IsSimulatingPhysics() || HitInfo.GetActor()->IsA<AVRPropActor>()))
 	{
 		// 잡았다
 		bIsGrabbed = true;
@@ -650,6 +1094,8 @@ void AVRPlayer::RemoteGrab()
 		// 잡은 원거리 물체가 손으로 끌려오도록 처리
 		GetWorldTimerManager().SetTimer(RemoteGrabTimer, FTimerDelegate::CreateLambda([this]()->void
 		{
+			VR_FEATURE_SCOPE(RemoteGrabPull);
+
 			// 이동 중간에 사용자가 놔버리면
 			if(GrabbedObject == nullptr)
 			{
@@ -660,29 +1106,28 @@ void AVRPlayer::RemoteGrab()
 			// 물체가 손 위치로 점차 다가오며 도착
 			FVector Pos = GrabbedObject->GetComponentLocation();
 			FVector TargetPos = RightHand->GetComponentLocation() + RightHand->GetForwardVector() * 100.f;
-			Pos = FMath::Lerp<FVector>(Pos, TargetPos, RemotePullSpeed * GetWorld()->DeltaTimeSeconds);
+			const bool bArrived = FVRSimulation::StepPull(Pos, TargetPos, RemotePullSpeed, RemotePullStepTime, 10.f);
 			GrabbedObject->SetWorldLocation(Pos);
 
 			// 목표에 거의 가까워졌다면
-			float Distance = FVector::Dist(Pos, TargetPos);
-			if(Distance < 10.f)
+			if(bArrived)
 			{
 				// 이동 중단하기
-				GrabbedObject->SetWorldLocation(TargetPos);
-
 				PrevPos = RightHand->GetComponentLocation();
 				PrevRot = RightHand->GetComponentQuat();
 				
 				GetWorldTimerManager().ClearTimer(RemoteGrabTimer);
 			}
 		}
-		), 0.02f, true);
+		), RemotePullStepTime, true);
 		
 	}
 }
 
 void AVRPlayer::DrawDebugRemoteGrab()
 {
+	VR_FEATURE_SCOPE(DebugRemoteGrab);
+
 	// 시각화 할 지 여부 확인 및 원거리 잡기 활성화 여부 확인
 	if(bDrawDebugGrab == false && bIsRemoteGrab == false)
 	{
@@ -693,16 +1138,26 @@ void AVRPlayer::DrawDebugRemoteGrab()
 	FVector StartPos = RightAim->GetComponentLocation();
 	// 트레이스 최대 거리
 	FVector EndPos = StartPos + RightAim->GetForwardVector() * RemoteGrabDistance;
-	// 충돌한 물체들을 기록할 배열
-	TArray<FOverlapResult> HitObjs;
+
+	// 묶음 처리 중이면 요청만 하고 결과에서 그린다.
+	const FVector Points[] = { StartPos, EndPos };
+	if(SubmitAimQuery(EVRAimQuery::RemoteGrabPreview, Points, RemoteRadius, ECC_Grabbable))
+	{
+		return;
+	}
+
 	// 충돌 질의 작성
-	FCollisionQueryParams Params;
-	Params.AddIgnoredActor(this);
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(VRDrawDebugRemoteGrab), false, this);
 	Params.AddIgnoredComponent(RightAim);
 
 	FHitResult HitInfo;
-	bool bHit = GetWorld()->SweepSingleByChannel(HitInfo, StartPos, EndPos, FQuat::Identity, ECC_Visibility, FCollisionShape::MakeSphere(RemoteRadius), Params);
+	CSV_CUSTOM_STAT(VRProject, SceneQueries, 1, ECsvCustomStatOp::Accumulate);
+	bool bHit = GetWorld()->SweepSingleByChannel(HitInfo, StartPos, EndPos, FQuat::Identity, ECC_Grabbable, FCollisionShape::MakeSphere(RemoteRadius), Params);
+	ApplyDebugRemoteGrab(bHit, HitInfo, StartPos);
+}
 
+void AVRPlayer::ApplyDebugRemoteGrab(bool bHit, const FHitResult& HitInfo, const FVector& StartPos)
+{
 	DrawDebugSphere(GetWorld(), StartPos, RemoteRadius, 10.f, FColor::Yellow);
 	if(bHit)
 	{
@@ -711,3 +1166,309 @@ void AVRPlayer::DrawDebugRemoteGrab()
 	}
 
 }
+
+bool AVRPlayer::SubmitAimQuery(EVRAimQuery Kind, TArrayView<const FVector> Points, float Radius, ECollisionChannel TraceChannel)
+{
+	auto AimQuery = GetWorld()->GetSubsystem<UVRAimQuerySubsystem>();
+	if(AimQuery == nullptr)
+	{
+		return false;
+	}
+
+	// 묶을 만큼 질의가 많지 않으면 지금 바로 트레이스 한다(한 프레임 늦는 것 방지).
+	if(AimQuery->ShouldBatch() == false)
+	{
+		AimQuery->CountSynchronous();
+		return false;
+	}
+
+	AimQuery->Submit(this, Kind, Points, Radius, TraceChannel);
+	return true;
+}
+
+bool AVRPlayer::TryUseImpactMarker()
+{
+	// 서버(스탠드얼론, 리슨 서버 호스트, 봇)는 게임 모드가 플레이어별로 센다.
+	if(auto GameMode = GetWorld()->GetAuthGameMode<AVRGameModeBase>())
+	{
+		return GameMode->TryUseImpactMarker(GetController(), ImpactMarkerLifetime);
+	}
+
+	// 원격 클라이언트는 표시를 자기 화면에만 만들므로 여기서 같은 예산으로 센다.
+	const float Now = GetWorld()->GetTimeSeconds();
+	ImpactMarkerExpiry.RemoveAllSwap([Now](float Expiry)
+	{
+		return Expiry <= Now;
+	});
+	if(ImpactMarkerExpiry.Num() >= AVRGameModeBase::GetPlayerBudget(GetWorld()).MaxImpactMarkers)
+	{
+		return false;
+	}
+	ImpactMarkerExpiry.Add(Now + ImpactMarkerLifetime);
+	return true;
+}
+
+void AVRPlayer::OnAimQueryResult(EVRAimQuery Kind, int32 HitSegment, const FHitResult& HitInfo, TArrayView<const FVector> Points)
+{
+	const bool bHit = HitSegment != INDEX_NONE;
+	switch(Kind)
+	{
+	case EVRAimQuery::Crosshair:
+		ApplyCrosshair(bHit, HitInfo, Points[0], Points.Last());
+		break;
+	case EVRAimQuery::TeleportArc:
+		// 요청 뒤에 텔레포트가 끝났으면 무시한다.
+		if(bTeleporting)
+		{
+			// 닿은 선분의 끝점까지를 그릴 곡선으로 한다.
+			Vertices.Reset();
+			Vertices.Append(Points.GetData(), bHit ? HitSegment + 2 : Points.Num());
+			ApplyTeleportHit(bHit, HitInfo, Vertices.Last());
+		}
+		break;
+	case EVRAimQuery::RemoteGrabPreview:
+		ApplyDebugRemoteGrab(bHit, HitInfo, Points[0]);
+		break;
+	}
+}
+
+void AVRPlayer::GetTrackedPose(FTransform& OutHead, FTransform& OutLeftHand, FTransform& OutRightHand) const
+{
+	OutHead = VRCamera->GetComponentTransform();
+	OutLeftHand = LeftHandMesh->GetComponentTransform();
+	OutRightHand = RightHandMesh->GetComponentTransform();
+}
+
+void AVRPlayer::RegisterWithWorldSystems()
+{
+	if(bRegisteredWithWorldSystems)
+	{
+		return;
+	}
+	bRegisteredWithWorldSystems = true;
+
+	// 손 애니메이션 예산 관리에 등록
+	if(auto HandAnimation = GetWorld()->GetSubsystem<UVRHandAnimationSubsystem>())
+	{
+		HandAnimation->RegisterHand(LeftHandMesh);
+		HandAnimation->RegisterHand(RightHandMesh);
+	}
+
+	// 중요도 관리에 등록
+	if(auto Significance = GetWorld()->GetSubsystem<UVRSignificanceSubsystem>())
+	{
+		Significance->RegisterPawn(this);
+	}
+}
+
+void AVRPlayer::UnregisterFromWorldSystems()
+{
+	if(bRegisteredWithWorldSystems == false)
+	{
+		return;
+	}
+	bRegisteredWithWorldSystems = false;
+
+	SetProxyMode(false);
+
+	if(auto HandAnimation = GetWorld()->GetSubsystem<UVRHandAnimationSubsystem>())
+	{
+		HandAnimation->UnregisterHand(LeftHandMesh);
+		HandAnimation->UnregisterHand(RightHandMesh);
+	}
+
+	if(auto Significance = GetWorld()->GetSubsystem<UVRSignificanceSubsystem>())
+	{
+		Significance->UnregisterPawn(this);
+	}
+}
+
+void AVRPlayer::OnAcquiredFromPool_Implementation()
+{
+	// 풀에 있는 동안 꺼 두었던 컴포넌트 Tick 복구
+	for(UActorComponent* Component : GetComponents())
+	{
+		if(Component->PrimaryComponentTick.bCanEverTick)
+		{
+			Component->SetComponentTickEnabled(Component->PrimaryComponentTick.bStartWithTickEnabled);
+		}
+	}
+
+	// 새 플레이어는 로컬 단계부터 시작한다(중요도 서브시스템이 다음 프레임에 다시 분류).
+	SignificanceTier = EVRSignificanceTier::Local;
+	SetActorTickInterval(0.f);
+
+	RegisterWithWorldSystems();
+	if(bInputAssetsReady)
+	{
+		AcquireCrosshair();
+	}
+	TeleportReset();
+}
+
+void AVRPlayer::OnReleasedToPool_Implementation()
+{
+	// 1. 잡고 있던 물체는 던지지 않고 그 자리에 놓는다.
+	if(bIsGrabbed && GrabbedObject)
+	{
+		GrabbedObject->DetachFromComponent(FDetachmentTransformRules::KeepWorldTransform);
+		GrabbedObject->SetSimulatePhysics(true);
+		GrabbedObject->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+	}
+	bIsGrabbed = false;
+	GrabbedObject = nullptr;
+
+	// 2. 진행 중인 워프/원거리 잡기 중단(워프 중이었다면 꺼 둔 이동과 충돌체도 되돌린다)
+	// (워프 타이머는 람다라서 ClearAllTimersForObject로 지워지지 않는다.)
+	const bool bWasWarping = GetWorldTimerManager().IsTimerActive(WarpHandle);
+	GetWorldTimerManager().ClearTimer(WarpHandle);
+	GetWorldTimerManager().ClearAllTimersForObject(this);
+	CurrentTime = 0.f;
+	if(bWasWarping)
+	{
+		FinishWarp();
+	}
+	if(auto VRMovement = Cast<UVRMovementComponent>(GetCharacterMovement()))
+	{
+		VRMovement->StopMovementImmediately();
+		VRMovement->NotifyTeleported();
+	}
+
+	// 3. 텔레포트 조준 초기화
+	TeleportReset();
+	TeleportStreaming->ClearPrediction();
+	Vertices.Reset();
+	CurrentNiagaraTime = 0.f;
+	ImpactMarkerExpiry.Reset();
+
+	// 4. 이전 플레이어의 자세와 설정이 다음 플레이어에게 남지 않도록 클래스 기본값으로 되돌린다.
+	NetPose = FVRNetPose();
+	bHasNetPose = false;
+	NetPoseTime = 0.f;
+	const AVRPlayer* Defaults = GetClass()->GetDefaultObject<AVRPlayer>();
+	bTeleportCurve = Defaults->bTeleportCurve;
+	bIsRemoteGrab = Defaults->bIsRemoteGrab;
+	bDrawDebugGrab = Defaults->bDrawDebugGrab;
+
+	// 5. 크로스헤어와 서브시스템 등록 반납
+	if(auto ActorPool = GetWorld()->GetSubsystem<UVRActorPoolSubsystem>())
+	{
+		ActorPool->Release(Crosshair);
+	}
+	Crosshair = nullptr;
+	UnregisterFromWorldSystems();
+
+	// 6. 풀에 있는 동안 컴포넌트 Tick(나이아가라, 손 추적, 위젯 상호작용, 이동 등)도 멈춘다.
+	for(UActorComponent* Component : GetComponents())
+	{
+		Component->SetComponentTickEnabled(false);
+	}
+}
+
+void AVRPlayer::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME_CONDITION(AVRPlayer, NetPose, COND_SkipOwner);
+}
+
+void AVRPlayer::UpdateNetPose(float DeltaTime)
+{
+	NetPoseTime += DeltaTime;
+	if(NetPoseTime < NetPoseInterval)
+	{
+		return;
+	}
+	NetPoseTime = 0.f;
+
+	// 액터 기준으로 보내서 복제된 액터 이동과 합친다.
+	const FTransform ActorTransform = GetActorTransform();
+	const FTransform Head = VRCamera->GetComponentTransform().GetRelativeTransform(ActorTransform);
+	const FTransform Left = LeftHandMesh->GetComponentTransform().GetRelativeTransform(ActorTransform);
+	const FTransform Right = RightHandMesh->GetComponentTransform().GetRelativeTransform(ActorTransform);
+
+	FVRNetPose Pose;
+	Pose.HeadLocation = Head.GetLocation();
+	Pose.HeadRotation = Head.Rotator();
+	Pose.LeftLocation = Left.GetLocation();
+	Pose.LeftRotation = Left.Rotator();
+	Pose.RightLocation = Right.GetLocation();
+	Pose.RightRotation = Right.Rotator();
+
+	if(HasAuthority())
+	{
+		// 서버가 조종하는 폰(리슨 서버 호스트, 봇)은 바로 설정한다.
+		NetPose = Pose;
+		OnRep_NetPose();
+	}
+	else
+	{
+		ServerSetNetPose(Pose);
+	}
+}
+
+void AVRPlayer::ServerSetNetPose_Implementation(const FVRNetPose& Pose)
+{
+	NetPose = Pose;
+	// 리슨 서버 호스트 화면의 프록시도 갱신
+	OnRep_NetPose();
+}
+
+void AVRPlayer::OnRep_NetPose()
+{
+	bHasNetPose = true;
+
+	if(IsProxyMode())
+	{
+		if(auto RemoteProxy = GetWorld()->GetSubsystem<UVRRemoteProxySubsystem>())
+		{
+			RemoteProxy->PushPose(ProxyIndex, GetProxyPose());
+		}
+	}
+}
+
+FVRProxyPose AVRPlayer::GetProxyPose() const
+{
+	if(bHasNetPose == false)
+	{
+		FTransform Head, Left, Right;
+		GetTrackedPose(Head, Left, Right);
+		return FVRProxyPose(Head, Left, Right);
+	}
+
+	const FTransform ActorTransform = GetActorTransform();
+	return FVRProxyPose(
+		FTransform(NetPose.HeadRotation, NetPose.HeadLocation) * ActorTransform,
+		FTransform(NetPose.LeftRotation, NetPose.LeftLocation) * ActorTransform,
+		FTransform(NetPose.RightRotation, NetPose.RightLocation) * ActorTransform);
+}
+
+void AVRPlayer::SetProxyMode(bool bEnable)
+{
+	if(IsProxyMode() == bEnable)
+	{
+		return;
+	}
+
+	auto RemoteProxy = GetWorld()->GetSubsystem<UVRRemoteProxySubsystem>();
+	if(bEnable)
+	{
+		ProxyIndex = RemoteProxy ? RemoteProxy->AddProxy(GetProxyPose(), this) : INDEX_NONE;
+		if(ProxyIndex == INDEX_NONE)
+		{
+			return;
+		}
+	}
+	else
+	{
+		if(RemoteProxy)
+		{
+			RemoteProxy->RemoveProxy(ProxyIndex);
+		}
+		ProxyIndex = INDEX_NONE;
+	}
+
+	// 프록시로 그리는 동안 손 메시는 숨긴다(안 보이는 손은 손 애니메이션 예산에서 평가하지 않는다).
+	LeftHandMesh->SetVisibility(bEnable == false);
+	RightHandMesh->SetVisibility(bEnable == false);
+}
@@ -0,0 +1,38 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "VRPlayerController.h"
+#include "VRGameModeBase.h"
+#include "TimerManager.h"
+
+static TAutoConsoleVariable<float> CVarSessionClientLifetime(
+	TEXT("vr.Session.ClientLifetime"),
+	0.f,
+	TEXT("If > 0, a network client quits this many seconds after joining. Set on clients launched by vr.Session.ChurnClients."));
+
+void AVRPlayerController::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// 접속/종료 반복 측정용 클라이언트는 정해진 시간 뒤 스스로 나간다(서버는 Logout/PawnLeavingGame을 거친다).
+	const float Lifetime = CVarSessionClientLifetime.GetValueOnGameThread();
+	if(Lifetime > 0.f && IsLocalController() && GetNetMode() == NM_Client)
+	{
+		FTimerHandle Handle;
+		GetWorldTimerManager().SetTimer(Handle, FTimerDelegate::CreateWeakLambda(this, []()
+		{
+			FPlatformMisc::RequestExit(false);
+		}), Lifetime, false);
+	}
+}
+
+void AVRPlayerController::PawnLeavingGame()
+{
+	if(auto GameMode = GetWorld()->GetAuthGameMode<AVRGameModeBase>())
+	{
+		GameMode->ReleasePlayerPawn(this);
+		return;
+	}
+
+	Super::PawnLeavingGame();
+}
@@ -4,3 +4,23 @@
 #include "Modules/ModuleManager.h"
 
 IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, VRProject, "VRProject" );
+
+DEFINE_LOG_CATEGORY(LogVRProject);
+
+CSV_DEFINE_CATEGORY_MODULE(VRPROJECT_API, VRProject, true);
+
+UE_TRACE_CHANNEL_DEFINE(VRProjectChannel);
+
+DEFINE_STAT(STAT_VR_PawnTick);
+DEFINE_STAT(STAT_VR_TeleportAim);
+DEFINE_STAT(STAT_VR_TeleportBeam);
+DEFINE_STAT(STAT_VR_Crosshair);
+DEFINE_STAT(STAT_VR_Grabbing);
+DEFINE_STAT(STAT_VR_DebugRemoteGrab);
+DEFINE_STAT(STAT_VR_Input);
+DEFINE_STAT(STAT_VR_Fire);
+DEFINE_STAT(STAT_VR_Grab);
+DEFINE_STAT(STAT_VR_Warp);
+DEFINE_STAT(STAT_VR_RemoteGrabPull);
+DEFINE_STAT(STAT_VR_HandAnimation);
+DEFINE_STAT(STAT_VR_Significance);
@@ -0,0 +1,26 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "VRPropActor.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/CollisionProfile.h"
+
+AVRPropActor::AVRPropActor()
+{
+	SetMobility(EComponentMobility::Movable);
+	GetStaticMeshComponent()->SetCollisionProfileName(UCollisionProfile::PhysicsActor_ProfileName);
+	GetStaticMeshComponent()->SetGenerateOverlapEvents(false);
+}
+
+void AVRPropActor::OnAcquiredFromPool_Implementation()
+{
+	// 메시와 물리는 꺼낸 쪽(UVRPropFieldSubsystem)에서 설정한다.
+	PromotedTime = GetWorld()->GetTimeSeconds();
+}
+
+void AVRPropActor::OnReleasedToPool_Implementation()
+{
+	GetStaticMeshComponent()->SetSimulatePhysics(false);
+	GetStaticMeshComponent()->SetStaticMesh(nullptr);
+	PropItemIndex = INDEX_NONE;
+}
@@ -0,0 +1,418 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "VRPropFieldSubsystem.h"
+#include "VRPropActor.h"
+#include "VRActorPoolSubsystem.h"
+#include "VRProject.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "GameFramework/PlayerController.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Props Instanced"), STAT_VRPropsInstanced, STATGROUP_VRProject);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Props Promoted"), STAT_VRPropsPromoted, STATGROUP_VRProject);
+
+bool UVRPropFieldSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UVRPropFieldSubsystem::Deinitialize()
+{
+	Positions.Empty();
+	Rotations.Empty();
+	Scales.Empty();
+	MeshIndices.Empty();
+	InstanceIndices.Empty();
+	Promoted.Empty();
+	Cells.Empty();
+	PromotedActors.Empty();
+
+	Super::Deinitialize();
+}
+
+FIntVector UVRPropFieldSubsystem::GetCell(const FVector& Location) const
+{
+	return FIntVector(
+		FMath::FloorToInt(Location.X / CellSize),
+		FMath::FloorToInt(Location.Y / CellSize),
+		FMath::FloorToInt(Location.Z / CellSize));
+}
+
+int32 UVRPropFieldSubsystem::FindOrAddMesh(UStaticMesh* Mesh)
+{
+	int32 MeshIndex = Meshes.Find(Mesh);
+	if(MeshIndex != INDEX_NONE)
+	{
+		return MeshIndex;
+	}
+
+	// 인스턴스 컴포넌트를 들고 있을 액터
+	if(InstanceOwner == nullptr)
+	{
+		FActorSpawnParameters Params;
+		Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		InstanceOwner = GetWorld()->SpawnActor<AActor>(Params);
+	}
+
+	// 인스턴스는 그리기만 하고 충돌은 승격된 액터가 맡는다.
+	auto Comp = NewObject<UHierarchicalInstancedStaticMeshComponent>(InstanceOwner);
+	Comp->SetMobility(EComponentMobility::Movable);
+	Comp->SetStaticMesh(Mesh);
+	Comp->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	Comp->SetCanEverAffectNavigation(false);
+	if(InstanceOwner->GetRootComponent() == nullptr)
+	{
+		InstanceOwner->SetRootComponent(Comp);
+	}
+	else
+	{
+		Comp->SetupAttachment(InstanceOwner->GetRootComponent());
+	}
+	Comp->RegisterComponent();
+	InstanceOwner->AddInstanceComponent(Comp);
+
+	Meshes.Add(Mesh);
+	MeshComponents.Add(Comp);
+	MeshRadii.Add(Mesh->GetBounds().SphereRadius);
+	return Meshes.Num() - 1;
+}
+
+void UVRPropFieldSubsystem::AddItems(UStaticMesh* Mesh, const TArray<FTransform>& Transforms)
+{
+	if(Mesh == nullptr || Transforms.Num() == 0)
+	{
+		return;
+	}
+
+	const int32 MeshIndex = FindOrAddMesh(Mesh);
+	UHierarchicalInstancedStaticMeshComponent* Comp = MeshComponents[MeshIndex];
+
+	// 스케일은 균일 스케일로 맞춘다.
+	TArray<FTransform> InstanceTransforms;
+	InstanceTransforms.Reserve(Transforms.Num());
+	for(const FTransform& Transform : Transforms)
+	{
+		InstanceTransforms.Add(FTransform(Transform.GetRotation(), Transform.GetLocation(), FVector(Transform.GetMaximumAxisScale())));
+	}
+	const TArray<int32> NewInstances = Comp->AddInstances(InstanceTransforms, true, true);
+
+	const int32 FirstItem = Positions.Num();
+	const int32 NewCount = FirstItem + InstanceTransforms.Num();
+	Positions.Reserve(NewCount);
+	Rotations.Reserve(NewCount);
+	Scales.Reserve(NewCount);
+	MeshIndices.Reserve(NewCount);
+	InstanceIndices.Reserve(NewCount);
+
+	for(int32 i = 0; i < InstanceTransforms.Num(); i++)
+	{
+		const FTransform& Transform = InstanceTransforms[i];
+		const int32 Item = Positions.Add(FVector3f(Transform.GetLocation()));
+		Rotations.Add(FQuat4f(Transform.GetRotation()));
+		Scales.Add(Transform.GetScale3D().X);
+		MeshIndices.Add(MeshIndex);
+		InstanceIndices.Add(NewInstances[i]);
+		Promoted.Add(false);
+		Cells.FindOrAdd(GetItemCell(Item)).Add(Item);
+	}
+
+	SET_DWORD_STAT(STAT_VRPropsInstanced, Positions.Num() - PromotedActors.Num());
+}
+
+FIntVector UVRPropFieldSubsystem::GetItemCell(int32 Item) const
+{
+	// 넣고 뺄 때 같은 칸이 나오도록 항상 저장된 float 위치로 계산한다.
+	return GetCell(FVector(Positions[Item]));
+}
+
+FTransform UVRPropFieldSubsystem::GetItemTransform(int32 Item) const
+{
+	return FTransform(FQuat(Rotations[Item]), FVector(Positions[Item]), FVector(Scales[Item]));
+}
+
+AVRPropActor* UVRPropFieldSubsystem::PromoteNearest(const FVector& Location, float Radius)
+{
+	const FIntVector Min = GetCell(Location - FVector(Radius));
+	const FIntVector Max = GetCell(Location + FVector(Radius));
+
+	int32 Closest = INDEX_NONE;
+	float ClosestDistSq = TNumericLimits<float>::Max();
+	for(int32 X = Min.X; X <= Max.X; X++)
+	{
+		for(int32 Y = Min.Y; Y <= Max.Y; Y++)
+		{
+			for(int32 Z = Min.Z; Z <= Max.Z; Z++)
+			{
+				const TArray<int32>* Items = Cells.Find(FIntVector(X, Y, Z));
+				if(Items == nullptr)
+				{
+					continue;
+				}
+				for(int32 Item : *Items)
+				{
+					if(Promoted[Item])
+					{
+						continue;
+					}
+					// 소품 크기만큼 범위를 넓혀서 비교
+					const float Reach = Radius + MeshRadii[MeshIndices[Item]] * Scales[Item];
+					const float DistSq = FVector3f::DistSquared(Positions[Item], FVector3f(Location));
+					if(DistSq < ClosestDistSq && DistSq <= Reach * Reach)
+					{
+						Closest = Item;
+						ClosestDistSq = DistSq;
+					}
+				}
+			}
+		}
+	}
+
+	return Closest != INDEX_NONE ? Promote(Closest) : nullptr;
+}
+
+AVRPropActor* UVRPropFieldSubsystem::PromoteAlongSweep(const FVector& Start, const FVector& End, float Radius)
+{
+	const FVector Delta = End - Start;
+	const float Length = Delta.Size();
+	if(Length <= KINDA_SMALL_NUMBER)
+	{
+		return PromoteNearest(Start, Radius);
+	}
+	const FVector Direction = Delta / Length;
+
+	// 선분을 따라 칸 크기 간격으로 주변 칸을 검사한다.
+	const int32 Range = FMath::CeilToInt(Radius / CellSize);
+	const int32 Steps = FMath::CeilToInt(Length / CellSize);
+	TSet<FIntVector> Visited;
+
+	int32 First = INDEX_NONE;
+	float FirstT = TNumericLimits<float>::Max();
+	for(int32 Step = 0; Step <= Steps; Step++)
+	{
+		// 이미 찾은 소품보다 먼 구간은 볼 필요 없다.
+		const float StepT = FMath::Min(Step * CellSize, Length);
+		if(StepT - (Range + 1) * CellSize > FirstT)
+		{
+			break;
+		}
+
+		const FIntVector Center = GetCell(Start + Direction * StepT);
+		for(int32 X = -Range; X <= Range; X++)
+		{
+			for(int32 Y = -Range; Y <= Range; Y++)
+			{
+				for(int32 Z = -Range; Z <= Range; Z++)
+				{
+					const FIntVector Cell = Center + FIntVector(X, Y, Z);
+					bool bAlreadyVisited = false;
+					Visited.Add(Cell, &bAlreadyVisited);
+					const TArray<int32>* Items = bAlreadyVisited ? nullptr : Cells.Find(Cell);
+					if(Items == nullptr)
+					{
+						continue;
+					}
+					for(int32 Item : *Items)
+					{
+						if(Promoted[Item])
+						{
+							continue;
+						}
+						const FVector Position(Positions[Item]);
+						const float T = FMath::Clamp<float>(FVector::DotProduct(Position - Start, Direction), 0.f, Length);
+						const float Reach = Radius + MeshRadii[MeshIndices[Item]] * Scales[Item];
+						if(T < FirstT && FVector::DistSquared(Start + Direction * T, Position) <= Reach * Reach)
+						{
+							First = Item;
+							FirstT = T;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	return First != INDEX_NONE ? Promote(First) : nullptr;
+}
+
+AVRPropActor* UVRPropFieldSubsystem::Promote(int32 Item)
+{
+	auto ActorPool = GetWorld()->GetSubsystem<UVRActorPoolSubsystem>();
+	if(ActorPool == nullptr || Promoted[Item] || PromotedActors.Num() >= MaxPromoted)
+	{
+		return nullptr;
+	}
+
+	const FTransform Transform = GetItemTransform(Item);
+	AVRPropActor* Actor = ActorPool->Acquire<AVRPropActor>(AVRPropActor::StaticClass(), Transform);
+	if(Actor == nullptr)
+	{
+		return nullptr;
+	}
+
+	UStaticMeshComponent* Mesh = Actor->GetStaticMeshComponent();
+	Mesh->SetStaticMesh(Meshes[MeshIndices[Item]]);
+	// 주변 인스턴스는 충돌이 없으므로 잡아서 놓기 전까지는 물리를 켜지 않는다(켜면 그 위에 있던 소품이 빠져 떨어진다).
+	Mesh->SetSimulatePhysics(false);
+	Actor->PropItemIndex = Item;
+
+	// 인스턴스는 숨기고 격자에서 뺀다.
+	MeshComponents[MeshIndices[Item]]->UpdateInstanceTransform(InstanceIndices[Item], FTransform(Transform.GetRotation(), Transform.GetLocation(), FVector::ZeroVector), true, true, true);
+	if(TArray<int32>* Items = Cells.Find(GetItemCell(Item)))
+	{
+		Items->RemoveSwap(Item);
+	}
+	Promoted[Item] = true;
+	PromotedActors.Add(Actor);
+	CSV_CUSTOM_STAT(VRProject, PropsPromoted, 1, ECsvCustomStatOp::Accumulate);
+	return Actor;
+}
+
+void UVRPropFieldSubsystem::Demote(AVRPropActor* Actor)
+{
+	const int32 Item = Actor->PropItemIndex;
+	const FTransform Transform = Actor->GetStaticMeshComponent()->GetComponentTransform();
+
+	// 잠든 자리로 인스턴스를 옮기고 격자에 다시 넣는다.
+	Positions[Item] = FVector3f(Transform.GetLocation());
+	Rotations[Item] = FQuat4f(Transform.GetRotation());
+	MeshComponents[MeshIndices[Item]]->UpdateInstanceTransform(InstanceIndices[Item], GetItemTransform(Item), true, true, true);
+	Cells.FindOrAdd(GetItemCell(Item)).AddUnique(Item);
+	Promoted[Item] = false;
+
+	if(auto ActorPool = GetWorld()->GetSubsystem<UVRActorPoolSubsystem>())
+	{
+		ActorPool->Release(Actor);
+	}
+}
+
+void UVRPropFieldSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	FrameSeconds += FApp::GetDeltaTime();
+	FrameCount++;
+
+	// 손에서 놓였고(물리 켜짐) 잠든 소품, 승격만 되고 잡히지 않은 소품은 다시 인스턴스로
+	const float Now = GetWorld()->GetTimeSeconds();
+	for(int32 i = PromotedActors.Num() - 1; i >= 0; i--)
+	{
+		AVRPropActor* Actor = PromotedActors[i];
+		if(IsValid(Actor) == false || Actor->PropItemIndex == INDEX_NONE)
+		{
+			PromotedActors.RemoveAtSwap(i);
+			continue;
+		}
+
+		UStaticMeshComponent* Mesh = Actor->GetStaticMeshComponent();
+		const bool bSettled = Mesh->IsSimulatingPhysics() ? Mesh->RigidBodyIsAwake() == false : Mesh->GetAttachParent() == nullptr;
+		if(bSettled && Now - Actor->PromotedTime > MinPromotedTime)
+		{
+			PromotedActors.RemoveAtSwap(i);
+			Demote(Actor);
+		}
+	}
+
+	SET_DWORD_STAT(STAT_VRPropsInstanced, Positions.Num() - PromotedActors.Num());
+	SET_DWORD_STAT(STAT_VRPropsPromoted, PromotedActors.Num());
+}
+
+TStatId UVRPropFieldSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UVRPropFieldSubsystem, STATGROUP_Tickables);
+}
+
+void UVRPropFieldSubsystem::Report()
+{
+	// 소품 데이터 + 격자 + 인스턴스 데이터
+	SIZE_T DataBytes = Positions.GetAllocatedSize() + Rotations.GetAllocatedSize() + Scales.GetAllocatedSize()
+		+ MeshIndices.GetAllocatedSize() + InstanceIndices.GetAllocatedSize() + Promoted.GetAllocatedSize();
+	SIZE_T GridBytes = Cells.GetAllocatedSize();
+	for(const TPair<FIntVector, TArray<int32>>& Cell : Cells)
+	{
+		GridBytes += Cell.Value.GetAllocatedSize();
+	}
+	SIZE_T InstanceBytes = 0;
+	for(UHierarchicalInstancedStaticMeshComponent* Comp : MeshComponents)
+	{
+		InstanceBytes += Comp->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+	}
+
+	const double AverageMs = FrameCount > 0 ? FrameSeconds * 1000.0 / FrameCount : 0.0;
+	UE_LOG(LogVRProject, Display, TEXT("Props items=%d promoted=%d meshes=%d cells=%d"), Positions.Num(), PromotedActors.Num(), Meshes.Num(), Cells.Num());
+	UE_LOG(LogVRProject, Display, TEXT("Props memory data=%.1f KB grid=%.1f KB instances=%.1f KB (%.1f bytes/item)"),
+		DataBytes / 1024.0, GridBytes / 1024.0, InstanceBytes / 1024.0, Positions.Num() > 0 ? double(DataBytes + GridBytes + InstanceBytes) / Positions.Num() : 0.0);
+	UE_LOG(LogVRProject, Display, TEXT("Props frame time avg=%.2f ms over %lld frames"), AverageMs, FrameCount);
+}
+
+void UVRPropFieldSubsystem::ResetFrameTimes()
+{
+	FrameSeconds = 0.0;
+	FrameCount = 0;
+}
+
+// 규모 테스트용 콘솔 명령
+// 예) -ExecCmds="vr.Props.Spawn 20000, vr.Props.ResetTimes" 후 일정 시간 뒤 vr.Props.Report
+static FAutoConsoleCommandWithWorldAndArgs GVRPropsSpawnCmd(
+	TEXT("vr.Props.Spawn"),
+	TEXT("Scatters N instanced grabbable props on a grid in front of the first player. Usage: vr.Props.Spawn [Count] [Spacing] [MeshPath]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		auto PropField = World ? World->GetSubsystem<UVRPropFieldSubsystem>() : nullptr;
+		const TCHAR* MeshPath = Args.Num() > 2 ? *Args[2] : TEXT("/Engine/BasicShapes/Cube.Cube");
+		UStaticMesh* Mesh = LoadObject<UStaticMesh>(nullptr, MeshPath);
+		if(PropField == nullptr || Mesh == nullptr)
+		{
+			return;
+		}
+
+		const int32 Count = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 20000;
+		const float Spacing = Args.Num() > 1 ? FCString::Atof(*Args[1]) : 40.f;
+
+		FVector Origin = FVector::ZeroVector;
+		if(APlayerController* PC = World->GetFirstPlayerController())
+		{
+			if(PC->GetPawn())
+			{
+				Origin = PC->GetPawn()->GetActorLocation() + PC->GetPawn()->GetActorForwardVector() * 200.f;
+			}
+		}
+
+		// 창고 선반처럼 여러 층으로 쌓는다.
+		const int32 Columns = FMath::Max(1, FMath::CeilToInt(FMath::Sqrt(Count / 4.f)));
+		TArray<FTransform> Transforms;
+		Transforms.Reserve(Count);
+		for(int32 i = 0; i < Count; i++)
+		{
+			const int32 Layer = i / (Columns * Columns);
+			const int32 Index = i % (Columns * Columns);
+			const FVector Location = Origin + FVector(Index / Columns * Spacing, (Index % Columns - Columns / 2) * Spacing, Layer * Spacing);
+			Transforms.Add(FTransform(FRotator(0.f, FMath::FRandRange(0.f, 360.f), 0.f), Location, FVector(0.15f)));
+		}
+		PropField->AddItems(Mesh, Transforms);
+
+		UE_LOG(LogVRProject, Display, TEXT("Spawned %d instanced props"), Count);
+	}));
+
+static FAutoConsoleCommandWithWorld GVRPropsReportCmd(
+	TEXT("vr.Props.Report"),
+	TEXT("Logs instanced prop memory and average frame time."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if(auto PropField = World ? World->GetSubsystem<UVRPropFieldSubsystem>() : nullptr)
+		{
+			PropField->Report();
+		}
+	}));
+
+static FAutoConsoleCommandWithWorld GVRPropsResetTimesCmd(
+	TEXT("vr.Props.ResetTimes"),
+	TEXT("Clears the instanced prop frame time measurement."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if(auto PropField = World ? World->GetSubsystem<UVRPropFieldSubsystem>() : nullptr)
+		{
+			PropField->ResetFrameTimes();
+		}
+	}));
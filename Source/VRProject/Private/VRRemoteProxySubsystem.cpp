@@ -0,0 +1,365 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "VRRemoteProxySubsystem.h"
+#include "VRPlayer.h"
+#include "VRProject.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "EngineUtils.h"
+#include "GameFramework/PlayerController.h"
+#include "UObject/UObjectHash.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Remote Proxies"), STAT_VRRemoteProxies, STATGROUP_VRProject);
+
+FVRProxyPose::FVRProxyPose(const FTransform& Head, const FTransform& Left, const FTransform& Right)
+	: HeadLocation(Head.GetLocation())
+	, HeadRotation(Head.GetRotation())
+	, LeftLocation(Left.GetLocation())
+	, LeftRotation(Left.GetRotation())
+	, RightLocation(Right.GetLocation())
+	, RightRotation(Right.GetRotation())
+{
+}
+
+FVRProxyPose FVRProxyPose::Interpolate(const FVRProxyPose& A, const FVRProxyPose& B, float Alpha)
+{
+	FVRProxyPose Result;
+	Result.HeadLocation = FMath::Lerp(A.HeadLocation, B.HeadLocation, Alpha);
+	Result.HeadRotation = FQuat4f::Slerp(A.HeadRotation, B.HeadRotation, Alpha);
+	Result.LeftLocation = FMath::Lerp(A.LeftLocation, B.LeftLocation, Alpha);
+	Result.LeftRotation = FQuat4f::Slerp(A.LeftRotation, B.LeftRotation, Alpha);
+	Result.RightLocation = FMath::Lerp(A.RightLocation, B.RightLocation, Alpha);
+	Result.RightRotation = FQuat4f::Slerp(A.RightRotation, B.RightRotation, Alpha);
+	return Result;
+}
+
+bool UVRRemoteProxySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UVRRemoteProxySubsystem::Deinitialize()
+{
+	FromPoses.Empty();
+	ToPoses.Empty();
+	FromTimes.Empty();
+	Owners.Empty();
+	Active.Empty();
+	FreeProxies.Empty();
+	NumActive = 0;
+
+	Super::Deinitialize();
+}
+
+bool UVRRemoteProxySubsystem::CreateComponents()
+{
+	if(InstanceOwner)
+	{
+		return true;
+	}
+
+	UStaticMesh* Head = HeadMesh.LoadSynchronous();
+	UStaticMesh* Hand = HandMesh.LoadSynchronous();
+	if(Head == nullptr || Hand == nullptr)
+	{
+		UE_LOG(LogVRProject, Warning, TEXT("Remote proxy meshes are not set ([/Script/VRProject.VRRemoteProxySubsystem] HeadMesh, HandMesh)"));
+		return false;
+	}
+
+	// 인스턴스 컴포넌트를 들고 있을 액터
+	FActorSpawnParameters Params;
+	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	InstanceOwner = GetWorld()->SpawnActor<AActor>(Params);
+
+	// 프록시는 그리기만 한다(충돌, 그림자 없음).
+	auto CreateComponent = [this](UStaticMesh* Mesh)
+	{
+		auto Comp = NewObject<UInstancedStaticMeshComponent>(InstanceOwner);
+		Comp->SetMobility(EComponentMobility::Movable);
+		Comp->SetStaticMesh(Mesh);
+		Comp->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		Comp->SetCanEverAffectNavigation(false);
+		Comp->SetCastShadow(false);
+		if(InstanceOwner->GetRootComponent() == nullptr)
+		{
+			InstanceOwner->SetRootComponent(Comp);
+		}
+		else
+		{
+			Comp->SetupAttachment(InstanceOwner->GetRootComponent());
+		}
+		Comp->RegisterComponent();
+		InstanceOwner->AddInstanceComponent(Comp);
+		return Comp;
+	};
+	HeadComponent = CreateComponent(Head);
+	HandComponent = CreateComponent(Hand);
+	return true;
+}
+
+int32 UVRRemoteProxySubsystem::AddProxy(const FVRProxyPose& Pose, AActor* Owner)
+{
+	if(CreateComponents() == false)
+	{
+		return INDEX_NONE;
+	}
+
+	const float Now = GetWorld()->GetTimeSeconds();
+
+	// 비어 있는 자리를 먼저 쓴다(인스턴스 번호가 프록시 번호와 같게 유지된다).
+	int32 Proxy;
+	if(FreeProxies.Num() > 0)
+	{
+		Proxy = FreeProxies.Pop(false);
+		FromPoses[Proxy] = Pose;
+		ToPoses[Proxy] = Pose;
+		FromTimes[Proxy] = Now;
+		Owners[Proxy] = Owner;
+		Active[Proxy] = true;
+	}
+	else
+	{
+		Proxy = FromPoses.Add(Pose);
+		ToPoses.Add(Pose);
+		FromTimes.Add(Now);
+		Owners.Add(Owner);
+		Active.Add(true);
+		HeadComponent->AddInstance(FTransform::Identity, true);
+		HandComponent->AddInstance(FTransform::Identity, true);
+		HandComponent->AddInstance(FTransform::Identity, true);
+	}
+
+	NumActive++;
+	bPosesDirty = true;
+	SET_DWORD_STAT(STAT_VRRemoteProxies, NumActive);
+	return Proxy;
+}
+
+void UVRRemoteProxySubsystem::RemoveProxy(int32 Proxy)
+{
+	if(Active.IsValidIndex(Proxy) == false || Active[Proxy] == false)
+	{
+		return;
+	}
+
+	// 인스턴스는 지우지 않고 크기 0으로 숨긴 뒤 자리를 재사용한다.
+	Active[Proxy] = false;
+	Owners[Proxy] = nullptr;
+	FreeProxies.Add(Proxy);
+	NumActive--;
+	bPosesDirty = true;
+	SET_DWORD_STAT(STAT_VRRemoteProxies, NumActive);
+}
+
+FVRProxyPose UVRRemoteProxySubsystem::GetCurrentPose(int32 Proxy, float Now) const
+{
+	const float Alpha = PoseInterval > 0.f ? FMath::Clamp((Now - FromTimes[Proxy]) / PoseInterval, 0.f, 1.f) : 1.f;
+	return FVRProxyPose::Interpolate(FromPoses[Proxy], ToPoses[Proxy], Alpha);
+}
+
+void UVRRemoteProxySubsystem::PushPose(int32 Proxy, const FVRProxyPose& Pose)
+{
+	if(Active.IsValidIndex(Proxy) == false || Active[Proxy] == false)
+	{
+		return;
+	}
+
+	// 지금 보이는 자세에서 출발해야 튀지 않는다.
+	const float Now = GetWorld()->GetTimeSeconds();
+	FromPoses[Proxy] = GetCurrentPose(Proxy, Now);
+	ToPoses[Proxy] = Pose;
+	FromTimes[Proxy] = Now;
+	bPosesDirty = true;
+}
+
+void UVRRemoteProxySubsystem::SimulateMotion(float Now)
+{
+	// 머리는 제자리에서 두리번거리고, 손은 머리 주위로 흔든다.
+	for(int32 Proxy = 0; Proxy < ToPoses.Num(); Proxy++)
+	{
+		if(Active[Proxy] == false || Owners[Proxy].IsExplicitlyNull() == false)
+		{
+			continue;
+		}
+
+		FVRProxyPose Pose = ToPoses[Proxy];
+		const float Phase = Now * 2.f + Proxy;
+		const FQuat4f Rotation = FQuat4f(FRotator3f(0.f, FMath::Sin(Phase) * 45.f, 0.f));
+		Pose.HeadRotation = Rotation;
+		Pose.LeftLocation = Pose.HeadLocation + Rotation.RotateVector(FVector3f(30.f, -25.f, -40.f + FMath::Sin(Phase * 1.7f) * 15.f));
+		Pose.LeftRotation = Rotation;
+		Pose.RightLocation = Pose.HeadLocation + Rotation.RotateVector(FVector3f(30.f, 25.f, -40.f + FMath::Cos(Phase * 1.3f) * 15.f));
+		Pose.RightRotation = Rotation;
+		PushPose(Proxy, Pose);
+	}
+}
+
+void UVRRemoteProxySubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if(HeadComponent == nullptr || FromPoses.Num() == 0)
+	{
+		return;
+	}
+
+	const float Now = GetWorld()->GetTimeSeconds();
+	if(bSimulatedMotion && Now - SimulatedPoseTime >= PoseInterval)
+	{
+		SimulatedPoseTime = Now;
+		SimulateMotion(Now);
+	}
+
+	// 보간이 끝났고 바뀐 것도 없으면 인스턴스를 건드리지 않는다.
+	bool bMoving = bPosesDirty;
+	for(int32 Proxy = 0; Proxy < FromTimes.Num() && bMoving == false; Proxy++)
+	{
+		bMoving = Active[Proxy] && Now - FromTimes[Proxy] < PoseInterval;
+	}
+	if(bMoving == false)
+	{
+		return;
+	}
+	bPosesDirty = false;
+
+	// 모든 인스턴스를 한 번에 갱신한다.
+	HeadTransforms.SetNum(FromPoses.Num(), false);
+	HandTransforms.SetNum(FromPoses.Num() * 2, false);
+	for(int32 Proxy = 0; Proxy < FromPoses.Num(); Proxy++)
+	{
+		const FVRProxyPose Pose = GetCurrentPose(Proxy, Now);
+		const float Visible = Active[Proxy] ? 1.f : 0.f;
+		HeadTransforms[Proxy] = FTransform(FQuat(Pose.HeadRotation), FVector(Pose.HeadLocation), FVector(HeadScale * Visible));
+		HandTransforms[Proxy * 2] = FTransform(FQuat(Pose.LeftRotation), FVector(Pose.LeftLocation), FVector(HandScale * Visible));
+		HandTransforms[Proxy * 2 + 1] = FTransform(FQuat(Pose.RightRotation), FVector(Pose.RightLocation), FVector(HandScale * Visible));
+	}
+	HeadComponent->BatchUpdateInstancesTransforms(0, HeadTransforms, true, true, true);
+	HandComponent->BatchUpdateInstancesTransforms(0, HandTransforms, true, true, true);
+}
+
+TStatId UVRRemoteProxySubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UVRRemoteProxySubsystem, STATGROUP_Tickables);
+}
+
+SIZE_T UVRRemoteProxySubsystem::GetActorFootprint(AActor* Actor, TMap<FName, SIZE_T>* OutBreakdown)
+{
+	SIZE_T Total = 0;
+	auto AddObject = [&Total, OutBreakdown](UObject* Object)
+	{
+		// 오브젝트 자체 크기 + 오브젝트가 따로 들고 있는 메모리
+		const SIZE_T Bytes = Object->GetClass()->GetStructureSize() + Object->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+		Total += Bytes;
+		if(OutBreakdown)
+		{
+			OutBreakdown->FindOrAdd(Object->GetClass()->GetFName()) += Bytes;
+		}
+	};
+
+	if(Actor)
+	{
+		AddObject(Actor);
+		ForEachObjectWithOuter(Actor, AddObject, true);
+	}
+	return Total;
+}
+
+void UVRRemoteProxySubsystem::Report()
+{
+	// 폰 1개(월드에 있는 첫 VR 폰)
+	AVRPlayer* Pawn = nullptr;
+	for(TActorIterator<AVRPlayer> It(GetWorld()); It; ++It)
+	{
+		Pawn = *It;
+		break;
+	}
+
+	SIZE_T PawnBytes = 0;
+	if(Pawn)
+	{
+		TMap<FName, SIZE_T> Breakdown;
+		PawnBytes = GetActorFootprint(Pawn, &Breakdown);
+		Breakdown.ValueSort([](SIZE_T A, SIZE_T B) { return A > B; });
+
+		UE_LOG(LogVRProject, Display, TEXT("Pawn %s footprint=%.1f KB"), *Pawn->GetName(), PawnBytes / 1024.0);
+		for(const TPair<FName, SIZE_T>& Pair : Breakdown)
+		{
+			UE_LOG(LogVRProject, Display, TEXT("  %-40s %8.1f KB"), *Pair.Key.ToString(), Pair.Value / 1024.0);
+		}
+	}
+	else
+	{
+		UE_LOG(LogVRProject, Display, TEXT("Pawn footprint: no VR pawn in the world"));
+	}
+
+	// 프록시 1개(자세 배열 + 인스턴스 컴포넌트를 프록시 수로 나눈 값)
+	// 프록시는 폰을 대신하지 않고 폰 위에 더해진다(손 메시를 숨기고 그리기/애니메이션만 줄인다). 메모리는 줄지 않는다.
+	const SIZE_T DataBytes = FromPoses.GetAllocatedSize() + ToPoses.GetAllocatedSize() + FromTimes.GetAllocatedSize()
+		+ Owners.GetAllocatedSize() + Active.GetAllocatedSize() + FreeProxies.GetAllocatedSize()
+		+ HeadTransforms.GetAllocatedSize() + HandTransforms.GetAllocatedSize();
+	const SIZE_T InstanceBytes = GetActorFootprint(InstanceOwner);
+	const double ProxyBytes = NumActive > 0 ? double(DataBytes + InstanceBytes) / NumActive : 0.0;
+
+	int32 NumPawnProxies = 0;
+	for(int32 Proxy = 0; Proxy < Owners.Num(); Proxy++)
+	{
+		NumPawnProxies += Active[Proxy] && Owners[Proxy].IsValid() ? 1 : 0;
+	}
+	UE_LOG(LogVRProject, Display, TEXT("Proxies count=%d (remote pawns=%d, simulated=%d) data=%.1f KB instances=%.1f KB (%.1f bytes/proxy)"),
+		NumActive, NumPawnProxies, NumActive - NumPawnProxies, DataBytes / 1024.0, InstanceBytes / 1024.0, ProxyBytes);
+	if(PawnBytes > 0 && NumPawnProxies > 0)
+	{
+		UE_LOG(LogVRProject, Display, TEXT("%d proxied remote players: pawns=%.1f KB + proxies=%.1f KB (no memory reduction, proxies add %.1f bytes per player)"),
+			NumPawnProxies, PawnBytes * NumPawnProxies / 1024.0, ProxyBytes * NumPawnProxies / 1024.0, ProxyBytes);
+	}
+}
+
+// 규모 테스트용 콘솔 명령
+// 예) vr.Proxy.Spawn 100 후 vr.Proxy.Report
+static FAutoConsoleCommandWithWorldAndArgs GVRProxySpawnCmd(
+	TEXT("vr.Proxy.Spawn"),
+	TEXT("Adds N remote player proxies on a grid in front of the first player, moving with simulated poses. Usage: vr.Proxy.Spawn [Count] [Spacing]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		auto RemoteProxy = World ? World->GetSubsystem<UVRRemoteProxySubsystem>() : nullptr;
+		if(RemoteProxy == nullptr)
+		{
+			return;
+		}
+
+		const int32 Count = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 100;
+		const float Spacing = Args.Num() > 1 ? FCString::Atof(*Args[1]) : 150.f;
+
+		FVector Origin = FVector::ZeroVector;
+		if(APlayerController* PC = World->GetFirstPlayerController())
+		{
+			if(APawn* Pawn = PC->GetPawn())
+			{
+				Origin = Pawn->GetActorLocation() + Pawn->GetActorForwardVector() * 300.f + FVector(0.f, 0.f, Pawn->BaseEyeHeight);
+			}
+		}
+
+		const int32 Columns = FMath::Max(1, FMath::CeilToInt(FMath::Sqrt(float(Count))));
+		for(int32 i = 0; i < Count; i++)
+		{
+			const FVector Head = Origin + FVector(i / Columns * Spacing, (i % Columns - Columns / 2) * Spacing, 0.f);
+			const FTransform Left(Head + FVector(30.f, -25.f, -40.f));
+			const FTransform Right(Head + FVector(30.f, 25.f, -40.f));
+			RemoteProxy->AddProxy(FVRProxyPose(FTransform(Head), Left, Right));
+		}
+		RemoteProxy->SetSimulatedMotion(true);
+
+		UE_LOG(LogVRProject, Display, TEXT("Spawned %d remote proxies"), Count);
+	}));
+
+static FAutoConsoleCommandWithWorld GVRProxyReportCmd(
+	TEXT("vr.Proxy.Report"),
+	TEXT("Logs the memory footprint of a VR pawn and the overhead a remote proxy adds on top of it."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if(auto RemoteProxy = World ? World->GetSubsystem<UVRRemoteProxySubsystem>() : nullptr)
+		{
+			RemoteProxy->Report();
+		}
+	}));
@@ -0,0 +1,221 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "VRSignificanceSubsystem.h"
+#include "VRPlayer.h"
+#include "VRProject.h"
+#include "VRHitchDetectorSubsystem.h"
+#include "Camera/PlayerCameraManager.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/PlayerController.h"
+#include "Misc/App.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pawns Local"), STAT_VRPawnsLocal, STATGROUP_VRProject);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pawns Near Remote"), STAT_VRPawnsNearRemote, STATGROUP_VRProject);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pawns Far Remote"), STAT_VRPawnsFarRemote, STATGROUP_VRProject);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pawns Culled"), STAT_VRPawnsCulled, STATGROUP_VRProject);
+
+static TAutoConsoleVariable<float> CVarSignificanceNearDistance(
+	TEXT("vr.Significance.NearDistance"),
+	1500.f,
+	TEXT("Remote VR pawns closer than this (and rendered) are NearRemote."));
+
+static TAutoConsoleVariable<float> CVarSignificanceCullDistance(
+	TEXT("vr.Significance.CullDistance"),
+	5000.f,
+	TEXT("Remote VR pawns further than this, or not rendered, are Culled."));
+
+void UVRSignificanceSubsystem::RegisterPawn(AVRPlayer* Pawn)
+{
+	if(Pawn)
+	{
+		Pawns.AddUnique(Pawn);
+	}
+}
+
+void UVRSignificanceSubsystem::UnregisterPawn(AVRPlayer* Pawn)
+{
+	Pawns.Remove(Pawn);
+}
+
+void UVRSignificanceSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	VR_FEATURE_SCOPE(Significance);
+
+	Pawns.RemoveAll([](const TWeakObjectPtr<AVRPlayer>& Pawn)
+	{
+		return Pawn.IsValid() == false;
+	});
+
+	// 중요도 기준이 될 시점(로컬 카메라)
+	// 데디케이티드 서버의 첫 번째 컨트롤러는 임의의 원격 클라이언트이므로, 서버에서는 모든 플레이어의 시점 중 가장 가까운 것을 쓰고 싶다.
+	TArray<FVector, TInlineAllocator<8>> ViewLocations;
+	if(GetWorld()->GetNetMode() == NM_DedicatedServer)
+	{
+		for(FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+		{
+			APlayerController* PC = It->Get();
+			if(PC && PC->GetPawn())
+			{
+				FVector Location;
+				FRotator Rotation;
+				PC->GetPlayerViewPoint(Location, Rotation);
+				ViewLocations.Add(Location);
+			}
+		}
+	}
+	else
+	{
+		APlayerController* PC = GetWorld()->GetFirstPlayerController();
+		if(PC && PC->PlayerCameraManager)
+		{
+			ViewLocations.Add(PC->PlayerCameraManager->GetCameraLocation());
+		}
+	}
+
+	const float NearDistanceSq = FMath::Square(CVarSignificanceNearDistance.GetValueOnGameThread());
+	const float CullDistanceSq = FMath::Square(CVarSignificanceCullDistance.GetValueOnGameThread());
+
+	// -nullrhi나 데디케이티드 서버는 아무것도 그리지 않으므로 화면에 보였는지는 보지 않고 거리로만 나눈다.
+	const bool bCanRender = FApp::CanEverRender();
+
+	FMemory::Memzero(TierPawnCount);
+	for(const TWeakObjectPtr<AVRPlayer>& WeakPawn : Pawns)
+	{
+		AVRPlayer* Pawn = WeakPawn.Get();
+
+		EVRSignificanceTier Tier;
+		if(Pawn->IsLocallyControlled())
+		{
+			Tier = EVRSignificanceTier::Local;
+		}
+		else
+		{
+			float DistanceSq = ViewLocations.Num() > 0 ? MAX_flt : 0.f;
+			for(const FVector& ViewLocation : ViewLocations)
+			{
+				DistanceSq = FMath::Min(DistanceSq, (float)FVector::DistSquared(ViewLocation, Pawn->GetActorLocation()));
+			}
+			// 프록시로 그리는 폰은 폰 자체가 그려지지 않으므로 거리로만 판단한다.
+			const bool bRendered = bCanRender == false || Pawn->IsProxyMode() || Pawn->WasRecentlyRendered(0.5f);
+			if(DistanceSq > CullDistanceSq || bRendered == false)
+			{
+				Tier = EVRSignificanceTier::Culled;
+			}
+			else if(DistanceSq > NearDistanceSq)
+			{
+				Tier = EVRSignificanceTier::FarRemote;
+			}
+			else
+			{
+				Tier = EVRSignificanceTier::NearRemote;
+			}
+		}
+
+		Pawn->SetSignificanceTier(Tier);
+		TierPawnCount[(int32)Tier]++;
+	}
+
+	SET_DWORD_STAT(STAT_VRPawnsLocal, TierPawnCount[(int32)EVRSignificanceTier::Local]);
+	SET_DWORD_STAT(STAT_VRPawnsNearRemote, TierPawnCount[(int32)EVRSignificanceTier::NearRemote]);
+	SET_DWORD_STAT(STAT_VRPawnsFarRemote, TierPawnCount[(int32)EVRSignificanceTier::FarRemote]);
+	SET_DWORD_STAT(STAT_VRPawnsCulled, TierPawnCount[(int32)EVRSignificanceTier::Culled]);
+}
+
+TStatId UVRSignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UVRSignificanceSubsystem, STATGROUP_Tickables);
+}
+
+void UVRSignificanceSubsystem::RecordTickTime(EVRSignificanceTier Tier, double Seconds)
+{
+	TierTickSeconds[(int32)Tier] += Seconds;
+	TierTickCount[(int32)Tier]++;
+}
+
+void UVRSignificanceSubsystem::ReportTickTimes()
+{
+	const UEnum* TierEnum = StaticEnum<EVRSignificanceTier>();
+	for(int32 i = 0; i < (int32)EVRSignificanceTier::Count; i++)
+	{
+		const double AverageMs = TierTickCount[i] > 0 ? TierTickSeconds[i] * 1000.0 / TierTickCount[i] : 0.0;
+		UE_LOG(LogVRProject, Display, TEXT("%-12s pawns=%4d ticks=%8lld avg=%.4f ms/pawn"), *TierEnum->GetNameStringByIndex(i), TierPawnCount[i], TierTickCount[i], AverageMs);
+	}
+}
+
+void UVRSignificanceSubsystem::ResetTickTimes()
+{
+	FMemory::Memzero(TierTickSeconds);
+	FMemory::Memzero(TierTickCount);
+}
+
+// 규모 테스트용 콘솔 명령
+// 예) -nullrhi -ExecCmds="vr.Significance.SpawnTestPawns 200, vr.Significance.ResetTimes" 후 일정 시간 뒤 vr.Significance.Report
+static FAutoConsoleCommandWithWorldAndArgs GVRSignificanceSpawnTestPawnsCmd(
+	TEXT("vr.Significance.SpawnTestPawns"),
+	TEXT("Spawns N unpossessed VR pawns in a grid around the first player. Usage: vr.Significance.SpawnTestPawns <Count> [Spacing]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if(World == nullptr)
+		{
+			return;
+		}
+
+		const int32 Count = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 200;
+		const float Spacing = Args.Num() > 1 ? FCString::Atof(*Args[1]) : 200.f;
+
+		// 게임 모드의 기본 폰(블루프린트) 클래스를 사용한다.
+		UClass* PawnClass = AVRPlayer::StaticClass();
+		if(AGameModeBase* GameMode = World->GetAuthGameMode())
+		{
+			if(GameMode->DefaultPawnClass && GameMode->DefaultPawnClass->IsChildOf(AVRPlayer::StaticClass()))
+			{
+				PawnClass = GameMode->DefaultPawnClass;
+			}
+		}
+
+		FVector Origin = FVector::ZeroVector;
+		if(APlayerController* PC = World->GetFirstPlayerController())
+		{
+			if(PC->GetPawn())
+			{
+				Origin = PC->GetPawn()->GetActorLocation();
+			}
+		}
+
+		FActorSpawnParameters Params;
+		Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+		const int32 Columns = FMath::Max(1, FMath::CeilToInt(FMath::Sqrt((float)Count)));
+		for(int32 i = 0; i < Count; i++)
+		{
+			const FVector Offset((i / Columns + 1) * Spacing, (i % Columns - Columns / 2) * Spacing, 0.f);
+			World->SpawnActor<AVRPlayer>(PawnClass, Origin + Offset, FRotator::ZeroRotator, Params);
+		}
+
+		UE_LOG(LogVRProject, Display, TEXT("Spawned %d test VR pawns"), Count);
+	}));
+
+static FAutoConsoleCommandWithWorld GVRSignificanceReportCmd(
+	TEXT("vr.Significance.Report"),
+	TEXT("Logs VR pawn count and game-thread ms per pawn for each significance tier."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if(auto Significance = World ? World->GetSubsystem<UVRSignificanceSubsystem>() : nullptr)
+		{
+			Significance->ReportTickTimes();
+		}
+	}));
+
+static FAutoConsoleCommandWithWorld GVRSignificanceResetTimesCmd(
+	TEXT("vr.Significance.ResetTimes"),
+	TEXT("Clears the per-tier tick time measurements."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if(auto Significance = World ? World->GetSubsystem<UVRSignificanceSubsystem>() : nullptr)
+		{
+			Significance->ResetTickTimes();
+		}
+	}));
@@ -0,0 +1,232 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "VRSimulation.h"
+#include "VRProject.h"
+#include "Math/VectorRegister.h"
+
+void FVRArcBatch::SetNum(int32 InNum)
+{
+	NumArcs = InNum;
+	const int32 Padded = Align(InNum, 4);
+	for(TArray<float>* Array : { &PosX, &PosY, &PosZ, &VelX, &VelY, &VelZ })
+	{
+		Array->SetNumZeroed(Padded);
+	}
+}
+
+void FVRArcBatch::Set(int32 Index, const FVector3f& Position, const FVector3f& Velocity)
+{
+	PosX[Index] = Position.X;
+	PosY[Index] = Position.Y;
+	PosZ[Index] = Position.Z;
+	VelX[Index] = Velocity.X;
+	VelY[Index] = Velocity.Y;
+	VelZ[Index] = Velocity.Z;
+}
+
+void FVRSimulation::SimulateArc(const FVector& Start, const FVector& Velocity, float Gravity, float StepTime, int32 VertexCount, TArray<FVector>& OutPoints)
+{
+	OutPoints.Reset(VertexCount);
+
+	FVector Position = Start;
+	FVector CurrentVelocity = Velocity;
+	OutPoints.Add(Position);
+	for(int32 i = 0; i < VertexCount - 1; i++)
+	{
+		// v = v0 + at
+		CurrentVelocity += FVector::UpVector * Gravity * StepTime;
+		// P = P0 + vt
+		Position += CurrentVelocity * StepTime;
+		OutPoints.Add(Position);
+	}
+}
+
+void FVRSimulation::SimulateArcs(const FVRArcBatch& Arcs, float Gravity, float StepTime, int32 StepCount, FVRArcBatchPoints& OutPoints)
+{
+	const int32 Padded = Arcs.PaddedNum();
+	OutPoints.PaddedNum = Padded;
+	OutPoints.StepCount = StepCount;
+	OutPoints.X.SetNumUninitialized(Padded * StepCount);
+	OutPoints.Y.SetNumUninitialized(Padded * StepCount);
+	OutPoints.Z.SetNumUninitialized(Padded * StepCount);
+	if(StepCount <= 0)
+	{
+		return;
+	}
+
+	const VectorRegister4Float Dt = VectorSetFloat1(StepTime);
+	const VectorRegister4Float GravityStep = VectorSetFloat1(Gravity * StepTime);
+
+	// 4개의 곡선을 레지스터 하나의 4개 레인에 넣고 끝까지 계산한다.
+	for(int32 Arc = 0; Arc < Padded; Arc += 4)
+	{
+		VectorRegister4Float PX = VectorLoad(&Arcs.PosX[Arc]);
+		VectorRegister4Float PY = VectorLoad(&Arcs.PosY[Arc]);
+		VectorRegister4Float PZ = VectorLoad(&Arcs.PosZ[Arc]);
+		const VectorRegister4Float VX = VectorLoad(&Arcs.VelX[Arc]);
+		const VectorRegister4Float VY = VectorLoad(&Arcs.VelY[Arc]);
+		VectorRegister4Float VZ = VectorLoad(&Arcs.VelZ[Arc]);
+
+		VectorStore(PX, &OutPoints.X[Arc]);
+		VectorStore(PY, &OutPoints.Y[Arc]);
+		VectorStore(PZ, &OutPoints.Z[Arc]);
+		for(int32 Step = 1; Step < StepCount; Step++)
+		{
+			VZ = VectorAdd(VZ, GravityStep);
+			PX = VectorMultiplyAdd(VX, Dt, PX);
+			PY = VectorMultiplyAdd(VY, Dt, PY);
+			PZ = VectorMultiplyAdd(VZ, Dt, PZ);
+
+			const int32 Index = Step * Padded + Arc;
+			VectorStore(PX, &OutPoints.X[Index]);
+			VectorStore(PY, &OutPoints.Y[Index]);
+			VectorStore(PZ, &OutPoints.Z[Index]);
+		}
+	}
+}
+
+FVector FVRSimulation::StepWarp(const FVector& Start, const FVector& End, float Elapsed, float Duration, float HoldAlpha, bool bDestinationReady)
+{
+	// 이전 호출 결과가 아니라 시작점과 경과 시간으로만 계산한다.
+	const float Progress = Duration > 0.f ? Elapsed / Duration : 1.f;
+	const float Alpha = bDestinationReady ? Progress : FMath::Min(Progress, HoldAlpha);
+	return FMath::Lerp<FVector>(Start, End, FMath::Clamp(Alpha, 0.f, 1.f));
+}
+
+bool FVRSimulation::StepPull(FVector& Position, const FVector& Target, float PullSpeed, float StepTime, float ArriveDistance)
+{
+	Position = FMath::Lerp<FVector>(Position, Target, FMath::Min(PullSpeed * StepTime, 1.f));
+
+	// 목표에 거의 가까워졌다면 도착
+	if(FVector::DistSquared(Position, Target) < ArriveDistance * ArriveDistance)
+	{
+		Position = Target;
+		return true;
+	}
+	return false;
+}
+
+FVector FVRSimulation::ThrowAngularVelocity(const FQuat& DeltaRotation, float DeltaTime)
+{
+	if(DeltaTime <= 0.f)
+	{
+		return FVector::ZeroVector;
+	}
+
+	// 각속도 = (1 / dt) * dTheta(특정 축 기준 변위 각도 Axis, Angle)
+	FVector Axis;
+	float Angle;
+	DeltaRotation.ToAxisAndAngle(Axis, Angle);
+	// 짧은 쪽으로 회전(180도가 넘으면 반대 방향)
+	Angle = FMath::UnwindRadians(Angle);
+	return (1.f / DeltaTime) * Angle * Axis;
+}
+
+// 스칼라/SIMD 곡선 계산 비교와 결정성 확인
+static FAutoConsoleCommand GVRSimulationBenchmarkCmd(
+	TEXT("vr.Sim.Benchmark"),
+	TEXT("Compares scalar and batched teleport arc evaluation. Usage: vr.Sim.Benchmark [Arcs] [Iterations] [Steps]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const int32 NumArcs = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 256;
+		const int32 Iterations = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 1000;
+		const int32 Steps = Args.Num() > 2 ? FMath::Max(2, FCString::Atoi(*Args[2])) : 40;
+		const float Gravity = -5000.f;
+		const float StepTime = 0.02f;
+
+		// 임의의 조준(고정 시드)
+		FRandomStream Random(0);
+		TArray<FVector> Starts, Velocities;
+		FVRArcBatch Batch;
+		Batch.SetNum(NumArcs);
+		for(int32 i = 0; i < NumArcs; i++)
+		{
+			Starts.Add(FVector(Random.FRandRange(-5000.f, 5000.f), Random.FRandRange(-5000.f, 5000.f), Random.FRandRange(50.f, 200.f)));
+			Velocities.Add(Random.GetUnitVector() * 1500.f);
+			Batch.Set(i, FVector3f(Starts[i]), FVector3f(Velocities[i]));
+		}
+
+		// 1. 스칼라
+		TArray<FVector> Points;
+		double Checksum = 0.0;
+		double Start = FPlatformTime::Seconds();
+		for(int32 It = 0; It < Iterations; It++)
+		{
+			for(int32 i = 0; i < NumArcs; i++)
+			{
+				FVRSimulation::SimulateArc(Starts[i], Velocities[i], Gravity, StepTime, Steps, Points);
+				Checksum += Points.Last().Z;
+			}
+		}
+		const double ScalarSeconds = FPlatformTime::Seconds() - Start;
+
+		// 2. SIMD 묶음
+		FVRArcBatchPoints BatchPoints;
+		Start = FPlatformTime::Seconds();
+		for(int32 It = 0; It < Iterations; It++)
+		{
+			FVRSimulation::SimulateArcs(Batch, Gravity, StepTime, Steps, BatchPoints);
+			Checksum += BatchPoints.Z.Last();
+		}
+		const double BatchSeconds = FPlatformTime::Seconds() - Start;
+
+		// 3. 두 방식의 차이와 같은 입력 반복 시 결과가 같은지
+		float MaxError = 0.f;
+		for(int32 i = 0; i < NumArcs; i++)
+		{
+			FVRSimulation::SimulateArc(Starts[i], Velocities[i], Gravity, StepTime, Steps, Points);
+			for(int32 Step = 0; Step < Steps; Step++)
+			{
+				MaxError = FMath::Max(MaxError, FVector3f::Dist(FVector3f(Points[Step]), BatchPoints.Get(i, Step)));
+			}
+		}
+		FVRArcBatchPoints Repeat;
+		FVRSimulation::SimulateArcs(Batch, Gravity, StepTime, Steps, Repeat);
+		const bool bDeterministic = FMemory::Memcmp(Repeat.X.GetData(), BatchPoints.X.GetData(), BatchPoints.X.Num() * sizeof(float)) == 0
+			&& FMemory::Memcmp(Repeat.Y.GetData(), BatchPoints.Y.GetData(), BatchPoints.Y.Num() * sizeof(float)) == 0
+			&& FMemory::Memcmp(Repeat.Z.GetData(), BatchPoints.Z.GetData(), BatchPoints.Z.Num() * sizeof(float)) == 0;
+
+		const double Evaluations = double(NumArcs) * Iterations;
+		UE_LOG(LogVRProject, Display, TEXT("Arc simulation %d arcs x %d steps: scalar %.1f ns/arc, batched %.1f ns/arc (%.2fx)"),
+			NumArcs, Steps, ScalarSeconds * 1e9 / Evaluations, BatchSeconds * 1e9 / Evaluations, ScalarSeconds / FMath::Max(BatchSeconds, 1e-9));
+		UE_LOG(LogVRProject, Display, TEXT("Arc simulation max scalar/batched difference %.4f cm, repeatable %s (checksum %.1f)"),
+			MaxError, bDeterministic ? TEXT("yes") : TEXT("NO"), Checksum);
+	}));
+
+// 워프 확인: 목적지가 준비되지 않은 동안 HoldAlpha에 머무르는지, 같은 입력이면 같은 결과인지
+static FAutoConsoleCommand GVRSimulationCheckWarpCmd(
+	TEXT("vr.Sim.CheckWarp"),
+	TEXT("Steps a warp at the pawn's fixed timer interval and checks that it holds at HoldAlpha until the destination is ready. Usage: vr.Sim.CheckWarp [HoldAlpha] [Duration] [HoldSeconds]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const float HoldAlpha = Args.Num() > 0 ? FCString::Atof(*Args[0]) : 0.9f;
+		const float Duration = Args.Num() > 1 ? FMath::Max(0.01f, FCString::Atof(*Args[1])) : 0.2f;
+		const float HoldSeconds = Args.Num() > 2 ? FCString::Atof(*Args[2]) : 2.f;
+		const float StepTime = 0.01f;
+		const FVector Start(0.f, 0.f, 100.f);
+		const FVector End(1000.f, 500.f, 100.f);
+		const FVector HoldPos = FMath::Lerp(Start, End, FMath::Clamp(HoldAlpha, 0.f, 1.f));
+
+		// 1. 목적지가 준비되지 않은 동안(Duration + HoldSeconds)
+		float Elapsed = 0.f;
+		float MaxHoldError = 0.f;
+		FVector Position = Start;
+		while(Elapsed < Duration + HoldSeconds)
+		{
+			Elapsed += StepTime;
+			Position = FVRSimulation::StepWarp(Start, End, Elapsed, Duration, HoldAlpha, false);
+			if(Elapsed >= Duration * HoldAlpha)
+			{
+				MaxHoldError = FMath::Max<float>(MaxHoldError, FVector::Dist(Position, HoldPos));
+			}
+		}
+		// 2. 같은 입력을 다시 넣어도 같은 위치인지
+		const bool bRepeatable = FVRSimulation::StepWarp(Start, End, Elapsed, Duration, HoldAlpha, false) == Position;
+		// 3. 준비되면 목적지에 도착하는지
+		const float ArriveError = FVector::Dist(FVRSimulation::StepWarp(Start, End, Elapsed, Duration, HoldAlpha, true), End);
+
+		const bool bPassed = MaxHoldError < KINDA_SMALL_NUMBER && bRepeatable && ArriveError < KINDA_SMALL_NUMBER;
+		UE_LOG(LogVRProject, Display, TEXT("Warp check hold=%.2f: max hold error %.4f cm, repeatable %s, arrive error %.4f cm -> %s"),
+			HoldAlpha, MaxHoldError, bRepeatable ? TEXT("yes") : TEXT("NO"), ArriveError, bPassed ? TEXT("PASSED") : TEXT("FAILED"));
+	}));
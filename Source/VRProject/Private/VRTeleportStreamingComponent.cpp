@@ -0,0 +1,112 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "VRTeleportStreamingComponent.h"
+#include "WorldPartition/WorldPartitionSubsystem.h"
+#include "VRProject.h"
+
+UVRTeleportStreamingComponent::UVRTeleportStreamingComponent()
+{
+	// 히치 측정 중에만 Tick 한다.
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+}
+
+void UVRTeleportStreamingComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if(auto WorldPartition = GetWorld()->GetSubsystem<UWorldPartitionSubsystem>())
+	{
+		WorldPartition->RegisterStreamingSourceProvider(this);
+	}
+}
+
+void UVRTeleportStreamingComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if(auto WorldPartition = GetWorld()->GetSubsystem<UWorldPartitionSubsystem>())
+	{
+		WorldPartition->UnregisterStreamingSourceProvider(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+bool UVRTeleportStreamingComponent::GetStreamingSource(FWorldPartitionStreamingSource& StreamingSource)
+{
+	// 조준 중인 목적지가 없으면 스트리밍 소스를 제공하지 않는다.
+	if(bHasPrediction == false)
+	{
+		return false;
+	}
+
+	StreamingSource.Name = *FString::Printf(TEXT("%s_Teleport"), *GetOwner()->GetName());
+	StreamingSource.Location = PredictedDestination;
+	StreamingSource.Rotation = GetOwner()->GetActorRotation();
+	StreamingSource.TargetState = EStreamingSourceTargetState::Activated;
+	StreamingSource.bBlockOnSlowLoading = false;
+	StreamingSource.Priority = EStreamingSourcePriority::High;
+	return true;
+}
+
+void UVRTeleportStreamingComponent::SetPredictedDestination(const FVector& Destination)
+{
+	bHasPrediction = true;
+	PredictedDestination = Destination;
+}
+
+void UVRTeleportStreamingComponent::ClearPrediction()
+{
+	bHasPrediction = false;
+}
+
+bool UVRTeleportStreamingComponent::IsDestinationStreamed() const
+{
+	if(bHasPrediction == false)
+	{
+		return true;
+	}
+
+	auto WorldPartition = GetWorld()->GetSubsystem<UWorldPartitionSubsystem>();
+	if(WorldPartition == nullptr || GetWorld()->IsPartitionedWorld() == false)
+	{
+		return true;
+	}
+
+	FWorldPartitionStreamingQuerySource QuerySource(PredictedDestination);
+	QuerySource.Radius = DestinationQueryRadius;
+	QuerySource.bUseGridLoadingRange = false;
+	return WorldPartition->IsStreamingCompleted(EWorldPartitionRuntimeCellState::Activated, { QuerySource }, false);
+}
+
+void UVRTeleportStreamingComponent::NotifyArrived()
+{
+	ClearPrediction();
+
+	FramesToTrack = HitchTrackFrames;
+	HitchCount = 0;
+	WorstFrameMs = 0.f;
+	SetComponentTickEnabled(FramesToTrack > 0);
+}
+
+void UVRTeleportStreamingComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	// 도착 직후 프레임 시간 기록
+	const float FrameMs = DeltaTime * 1000.f;
+	WorstFrameMs = FMath::Max(WorstFrameMs, FrameMs);
+	if(FrameMs > HitchThresholdMs)
+	{
+		HitchCount++;
+		CSV_CUSTOM_STAT(VRProject, PostTeleportHitches, 1, ECsvCustomStatOp::Accumulate);
+	}
+
+	FramesToTrack--;
+	if(FramesToTrack <= 0)
+	{
+		UE_LOG(LogVRProject, Log, TEXT("%s: post-teleport %d frames, hitches=%d, worst=%.2f ms"), *GetOwner()->GetName(), HitchTrackFrames, HitchCount, WorstFrameMs);
+		CSV_CUSTOM_STAT(VRProject, PostTeleportWorstFrameMs, WorstFrameMs, ECsvCustomStatOp::Max);
+		SetComponentTickEnabled(false);
+	}
+}
@@ -17,4 +17,14 @@ class VRPROJECT_API UCMenu : public UUserWidget
 public:
 	UFUNCTION(BlueprintCallable, Category="MenuEvent")
 	void QuitVRGame();
+
+	// 상태가 바뀌었을 때 다시 그리도록 요청(수동 redraw)
+	UFUNCTION(BlueprintCallable, Category="MenuEvent")
+	void RequestRedraw();
+
+protected:
+	virtual void NativeOnInitialized() override;
+	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+	virtual int32 NativePaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+	virtual void OnAnimationStartedPlaying(UUMGSequencePlayer& Player) override;
 };
@@ -0,0 +1,102 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/StreamableManager.h"
+#include "VRActorPoolSubsystem.generated.h"
+
+// 맵 시작 시 미리 만들어 둘 액터 설정
+USTRUCT()
+struct FVRActorPoolConfig
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Actor Pool")
+	TSoftClassPtr<AActor> ActorClass;
+	// 미리 만들 개수
+	UPROPERTY(EditAnywhere, Category = "Actor Pool")
+	int32 PrewarmCount = 0;
+	// 클래스별 최대 개수(0이면 제한 없음)
+	UPROPERTY(EditAnywhere, Category = "Actor Pool")
+	int32 MaxCount = 0;
+};
+
+// 클래스 하나의 풀
+USTRUCT()
+struct FVRActorPool
+{
+	GENERATED_BODY()
+
+	// 쉬고 있는 액터
+	UPROPERTY()
+	TArray<AActor*> FreeActors;
+	// 풀이 만든 전체 액터 수(사용 중 + 쉬는 중)
+	int32 TotalCount = 0;
+	// 최대 개수(0이면 제한 없음)
+	int32 MaxCount = 0;
+};
+
+// 액터 풀
+// 1. 크로스헤어, 충돌 표시, 투사체처럼 자주 만들고 없애는 액터를 SpawnActor/Destroy 대신 재사용하고 싶다.
+// 2. 맵 시작 시 미리 만들어 두고, 클래스별 최대 개수를 제한하고 싶다.
+// 3. 미리 만들 클래스는 비동기로 불러와서 맵 시작 때 로딩 히치를 만들지 않고 싶다.
+// 4. vr.ActorPool.Enabled 0이면 풀을 거치지 않고 매번 만들고 파괴해서, vr.ActorPool.Session으로 같은 세션을 풀 사용/미사용으로 비교하고 싶다.
+UCLASS(Config = Game)
+class VRPROJECT_API UVRActorPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	// 풀에서 꺼내기(없으면 새로 만든다). 최대 개수에 도달하면 nullptr.
+	AActor* Acquire(UClass* ActorClass, const FTransform& Transform);
+	template<typename T>
+	T* Acquire(UClass* ActorClass, const FTransform& Transform)
+	{
+		return Cast<T>(Acquire(ActorClass, Transform));
+	}
+	// 일정 시간 뒤 자동으로 돌려놓는다.
+	AActor* AcquireForDuration(UClass* ActorClass, const FTransform& Transform, float Duration);
+
+	// 풀에 돌려놓기. 이미 돌려놓은 풀 액터면 무시하고, 풀이 만든 적 없는 액터면 Destroy.
+	void Release(AActor* Actor);
+
+	// 미리 만들어 두기
+	void Prewarm(UClass* ActorClass, int32 Count, int32 MaxCount = 0);
+
+	// 맵 시작 시 미리 만들 액터 목록
+	UPROPERTY(Config)
+	TArray<FVRActorPoolConfig> PrewarmClasses;
+
+	// 통계
+	int32 GetNumSpawned() const { return NumSpawned; }
+	int32 GetNumReused() const { return NumReused; }
+
+private:
+	UPROPERTY()
+	TMap<UClass*, FVRActorPool> Pools;
+	// 사용 중인 액터와 그 클래스
+	UPROPERTY()
+	TMap<AActor*, UClass*> ActiveActors;
+	// 사용 중인 액터를 꺼낸 번호(AcquireForDuration 타이머가 다음 사용을 돌려놓지 않게)
+	TMap<AActor*, uint32> ActiveSerials;
+	uint32 LastSerial = 0;
+
+	int32 NumSpawned = 0;
+	int32 NumReused = 0;
+
+	// 미리 만들 클래스 비동기 로딩
+	TSharedPtr<FStreamableHandle> PrewarmLoadHandle;
+	void OnPrewarmClassesLoaded();
+
+	// 새 액터 만들기
+	AActor* SpawnPooledActor(UClass* ActorClass, const FTransform& Transform);
+	// 꺼낼 때/돌려놓을 때 기본 상태 전환
+	void ActivateActor(AActor* Actor, const FTransform& Transform);
+	void DeactivateActor(AActor* Actor);
+};
@@ -0,0 +1,105 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "VRAimQuerySubsystem.generated.h"
+
+// 폰이 매 프레임 요청하는 조준 질의 종류
+enum class EVRAimQuery : uint8
+{
+	// 크로스헤어 직선
+	Crosshair,
+	// 텔레포트 곡선(선분을 순서대로 검사해 처음 닿는 곳)
+	TeleportArc,
+	// 원거리 잡기 미리보기(구 쓸기)
+	RemoteGrabPreview,
+};
+
+// 물리 이후(PostPhysics) 전에 모아 둔 질의를 실행하는 Tick
+USTRUCT()
+struct FVRAimQueryTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	class UVRAimQuerySubsystem* Owner = nullptr;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FVRAimQueryTickFunction> : public TStructOpsTypeTraitsBase2<FVRAimQueryTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
+// 여러 폰의 조준 질의를 한 번에 처리
+// 1. 폰들이 Tick에서 요청한 질의를 배열(SoA)에 모으고 싶다.
+// 2. 물리 중(TG_DuringPhysics)에 읽기 전용 물리 씬에 대해 ParallelFor로 나눠 실행하고 싶다.
+// 3. 결과는 PostPhysics 전에 게임 스레드에서 각 폰에 돌려주고 싶다.
+// 4. TeleportFloor 프로필로 다시 저장하지 않은 맵의 바닥(이름으로 찾는다)에 프로필을 입히고 싶다.
+UCLASS(Config = Game)
+class VRPROJECT_API UVRAimQuerySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	// 이번 프레임 질의를 묶어서 처리할지
+	// vr.AimQuery.Batch가 켜져 있고 지난 프레임 질의 수가 vr.AimQuery.MinParallel 이상일 때만 묶는다.
+	// (로컬 플레이어 1명뿐이면 질의가 몇 개 안 되므로 한 프레임 늦게 받을 이유가 없다. 봇이 많은 서버에서 묶인다.)
+	bool ShouldBatch() const;
+	// 묶지 않고 바로 트레이스 한 질의 수 기록
+	void CountSynchronous(int32 Num = 1) { FrameQueries += Num; }
+
+	// 질의 요청(Points는 선분들의 꼭짓점, Radius가 0이면 선, 아니면 구 쓸기)
+	void Submit(class AVRPlayer* Requester, EVRAimQuery Kind, TArrayView<const FVector> Points, float Radius, ECollisionChannel Channel);
+	int32 GetNumPending() const { return Kinds.Num(); }
+
+	// 모아 둔 질의를 실행하고 결과를 돌려준다.
+	void ExecuteBatch(bool bParallel = true);
+	// 매 프레임 Tick: 질의 수를 넘기고 묶음을 실행한다.
+	void TickBatch();
+
+	// 이름에 이 문자열이 들어간 액터는 TeleportFloor 프로필로 바꾼다(맵을 다시 저장하기 전 호환용, 비우면 끈다).
+	UPROPERTY(Config)
+	TArray<FString> LegacyTeleportFloorNames;
+
+private:
+	FVRAimQueryTickFunction TickFunction;
+
+	// 질의(SoA)
+	TArray<TWeakObjectPtr<class AVRPlayer>> Requesters;
+	TArray<EVRAimQuery> Kinds;
+	TArray<int32> PointOffsets;
+	TArray<int32> PointCounts;
+	TArray<FVector> Points;
+	TArray<float> Radii;
+	TArray<ECollisionChannel> Channels;
+
+	// 프레임별 질의 수(묶음 + 바로 트레이스)
+	int32 FrameQueries = 0;
+	int32 LastFrameQueries = 0;
+
+	// 결과(SoA)
+	TArray<FHitResult> Hits;
+	TArray<int32> HitSegments;
+
+	// 질의 하나 실행(워커 스레드)
+	void RunQuery(int32 Index);
+	void ResetBatch();
+
+	// 옛 바닥 액터에 TeleportFloor 프로필 적용(맵 시작, 스트리밍된 레벨)
+	void ApplyLegacyTeleportFloors(const TArray<AActor*>& Actors);
+	void OnLevelAdded(class ULevel* Level, UWorld* World);
+	FDelegateHandle LevelAddedHandle;
+};
@@ -0,0 +1,88 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AIController.h"
+#include "InputActionValue.h"
+#include "VRBotController.generated.h"
+
+// 봇 행동 성향
+UENUM(BlueprintType)
+enum class EVRBotBehavior : uint8
+{
+	// 주로 걸어다닌다.
+	Wanderer,
+	// 주로 텔레포트 한다.
+	Teleporter,
+	// 주로 잡았다 놓는다.
+	GrabSpammer,
+	// 주로 총을 쏜다.
+	Shooter,
+	// 골고루 섞어서 한다.
+	Mixed
+};
+
+// 헤드셋 없이 VR 폰 부하 테스트를 하고 싶다.
+// 1. HMD/컨트롤러 움직임을 절차적으로 만들어 폰에 적용한다.
+// 2. 이동/텔레포트/잡기/총쏘기 입력을 행동 성향에 따라 주입한다.
+UCLASS()
+class VRPROJECT_API AVRBotController : public AAIController
+{
+	GENERATED_BODY()
+
+public:
+	AVRBotController();
+
+	virtual void Tick(float DeltaTime) override;
+
+protected:
+	virtual void OnPossess(APawn* InPawn) override;
+	virtual void OnUnPossess() override;
+
+public:
+	// 행동 성향
+	UPROPERTY(EditAnywhere, Category = "Bot")
+	EVRBotBehavior Behavior = EVRBotBehavior::Mixed;
+	// 행동 사이 평균 간격(초)
+	UPROPERTY(EditAnywhere, Category = "Bot")
+	float ActionInterval = 1.f;
+	// 머리 움직임 크기
+	UPROPERTY(EditAnywhere, Category = "Bot")
+	float HeadMotionAmplitude = 10.f;
+	// 손 움직임 크기
+	UPROPERTY(EditAnywhere, Category = "Bot")
+	float HandMotionAmplitude = 20.f;
+
+	// 봇마다 다르게 움직이도록 시드 설정
+	void SetRandomSeed(int32 Seed);
+
+private:
+	UPROPERTY()
+	class AVRPlayer* VRPawn;
+
+	FRandomStream Random;
+	// 경과 시간
+	float ElapsedTime = 0.f;
+	// 위상(봇마다 다르게)
+	float MotionPhase = 0.f;
+	// 다음 행동 시각
+	float NextActionTime = 0.f;
+
+	// 이동 입력 유지
+	FVector2D MoveAxis = FVector2D::ZeroVector;
+	float MoveEndTime = 0.f;
+	// 텔레포트 버튼 유지
+	bool bTeleportHeld = false;
+	float TeleportReleaseTime = 0.f;
+	// 잡기 버튼 유지
+	bool bGrabHeld = false;
+	float GrabReleaseTime = 0.f;
+
+	// 절차적 HMD/컨트롤러 움직임
+	void UpdateTrackingPose();
+	// 눌린 버튼 유지/해제 처리
+	void UpdateHeldInputs();
+	// 성향에 따라 다음 행동 선택
+	void DoNextAction();
+};
@@ -6,13 +6,109 @@
 #include "GameFramework/GameModeBase.h"
 #include "VRGameModeBase.generated.h"
 
-/**
- * 
- */
-UCLASS()
+// 플레이어 1명당 자원 예산
+USTRUCT()
+struct FVRPlayerBudget
+{
+	GENERATED_BODY()
+
+	// 동시에 남아 있을 수 있는 충돌 표시 수
+	UPROPERTY(EditAnywhere, Category = "Budget")
+	int32 MaxImpactMarkers = 8;
+	// 폰 Tick + 이동 게임 스레드 시간 예산(평균)
+	UPROPERTY(EditAnywhere, Category = "Budget")
+	float PawnTickBudgetMs = 0.25f;
+};
+
+// 여러 명이 들어왔다 나가는 세션용 게임 모드
+// 1. 미리 만들어 둔 VR 폰을 접속/종료 때 꺼내 쓰고 돌려놓고 싶다(폰 상태는 풀 훅에서 초기화).
+// 2. 플레이어별 자원 예산을 추적하고 싶다.
+//    - 충돌 표시는 각자 자기 화면에만 만드므로, 서버는 서버가 조종하는 폰(리슨 서버 호스트, 봇)만 세고
+//      원격 클라이언트는 GameState로 받은 게임 모드 클래스의 PlayerBudget으로 자기 표시 수를 제한한다.
+//    - 서버 비용(폰 Tick, 이동 Tick, 클라이언트가 보낸 이동 처리)은 중요도 단계와 상관없이 컨트롤러마다 기록한다.
+// 3. 접속 처리 시간과 GC 시간을 측정하고 싶다.
+//    - vr.Session.Churn: 서버 안의 봇이 RestartPlayer로 들어왔다 나간다(네트워크 접속과 클라이언트 GC는 측정하지 않는다).
+//    - vr.Session.ChurnClients: 실제 클라이언트 프로세스(-nullrhi)를 띄워 접속/종료를 반복한다(PostLogin, PlayerState, 채널 열기, 각 클라이언트의 -csvprofile GC).
+UCLASS(Config = Game)
 class VRPROJECT_API AVRGameModeBase : public AGameModeBase
 {
 	GENERATED_BODY()
 
-	
+public:
+	AVRGameModeBase();
+
+	virtual void StartPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void PostLogin(APlayerController* NewPlayer) override;
+	virtual void Logout(AController* Exiting) override;
+	virtual APawn* SpawnDefaultPawnAtTransform_Implementation(AController* NewPlayer, const FTransform& SpawnTransform) override;
+
+	// 컨트롤러의 폰을 풀에 돌려놓는다.
+	void ReleasePlayerPawn(AController* Controller);
+
+	// 예산 안이면 충돌 표시 하나를 쓴다.
+	bool TryUseImpactMarker(AController* Controller, float Lifetime);
+	// 폰 Tick 시간 기록
+	void RecordPawnTick(AController* Controller, double Seconds);
+	// 폰 이동 시간 기록(서버의 이동 Tick, 클라이언트가 보낸 이동 처리)
+	void RecordPawnMovement(AController* Controller, double Seconds);
+	// 서버/클라이언트 어디서나 쓸 수 있는 플레이어 예산(클라이언트는 GameState의 게임 모드 클래스 기본값)
+	static FVRPlayerBudget GetPlayerBudget(const UWorld* World);
+
+	// 접속/GC/예산 측정값 로그
+	void ReportSession();
+	void ResetSessionStats();
+
+	// 봇이 계속 들어왔다 나가게 한다(0이면 중지).
+	void StartBotChurn(int32 BotCount, float Interval);
+	// 클라이언트 프로세스가 계속 들어왔다 나가게 한다(각 클라이언트는 Lifetime초 뒤 종료, 0이면 중지).
+	void StartClientChurn(int32 ClientCount, float Lifetime);
+
+	// 미리 만들어 둘 폰 수
+	UPROPERTY(Config)
+	int32 PawnPoolSize = 8;
+	// 플레이어 1명당 예산
+	UPROPERTY(Config)
+	FVRPlayerBudget PlayerBudget;
+
+private:
+	struct FVRPlayerUsage
+	{
+		// 충돌 표시가 사라지는 시각
+		TArray<float> ImpactMarkerExpiry;
+		double TickMsAverage = 0.0;
+		double MoveMsAverage = 0.0;
+		int32 OverBudgetTicks = 0;
+		int32 DeniedImpactMarkers = 0;
+	};
+	TMap<TWeakObjectPtr<AController>, FVRPlayerUsage> PlayerUsage;
+
+	// 접속 측정
+	void RecordJoin(double Seconds);
+	int32 JoinCount = 0;
+	double JoinTotalSeconds = 0.0;
+	double JoinMaxSeconds = 0.0;
+
+	// GC 측정
+	void OnPreGarbageCollect();
+	void OnPostGarbageCollect();
+	double GCStartTime = 0.0;
+	int32 GCCount = 0;
+	double GCTotalSeconds = 0.0;
+	double GCMaxSeconds = 0.0;
+
+	// 봇 접속/종료 반복
+	void ChurnStep();
+	FTimerHandle ChurnTimer;
+	int32 ChurnBotCount = 0;
+	UPROPERTY(Transient)
+	TArray<class AVRBotController*> ChurnBots;
+
+	// 클라이언트 프로세스 접속/종료 반복
+	void ClientChurnStep();
+	void StopClientChurn();
+	FTimerHandle ClientChurnTimer;
+	int32 ChurnClientCount = 0;
+	float ChurnClientLifetime = 0.f;
+	TArray<FProcHandle> ChurnClients;
 };
@@ -0,0 +1,65 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HeadMountedDisplayTypes.h"
+
+// 손 제스처(여러 개가 동시에 켜질 수 있다)
+enum class EVRGesture : uint8
+{
+	None	= 0,
+	Pinch	= 1 << 0,
+	Grab	= 1 << 1,
+	Point	= 1 << 2,
+};
+ENUM_CLASS_FLAGS(EVRGesture);
+
+// 한 손의 관절 위치(EHandKeypoint 순서)
+struct VRPROJECT_API FVRHandJoints
+{
+	FVector3f Positions[EHandKeypointCount];
+	bool bValid = false;
+
+	// FXRMotionControllerData::HandKeyPositions 에서 채운다.
+	void SetFromKeyPositions(const TArray<FVector>& KeyPositions);
+};
+
+// 제스처 판정 기준(손 크기에 대한 비율)
+struct VRPROJECT_API FVRGestureThresholds
+{
+	// 엄지 끝-검지 끝 거리 / 손바닥 길이
+	float PinchOn = 0.2f;
+	float PinchOff = 0.3f;
+	// 손가락 끝-손바닥 거리 / 손가락 시작 마디-손바닥 거리
+	float CurlOn = 1.1f;
+	float CurlOff = 1.3f;
+	// 이보다 크면 펴진 손가락
+	float Extended = 1.6f;
+};
+
+// 두 손 제스처 인식기
+// - 엔진 월드/컴포넌트에 의존하지 않아서 기록된 관절 데이터로 오프라인 테스트가 가능하다.
+// - 네 손가락을 SIMD 레지스터 한 개의 4개 레인에 넣어 한 번에 계산한다.
+class VRPROJECT_API FVRGestureRecognizer
+{
+public:
+	// 두 손을 평가하고 이전 결과와 비교해 시작/종료된 제스처를 기록한다.
+	void Evaluate(const FVRHandJoints& Left, const FVRHandJoints& Right);
+
+	// 0: 왼손, 1: 오른손
+	EVRGesture GetGestures(int32 HandIndex) const { return Current[HandIndex]; }
+	EVRGesture GetStarted(int32 HandIndex) const { return Current[HandIndex] & ~Previous[HandIndex]; }
+	EVRGesture GetEnded(int32 HandIndex) const { return Previous[HandIndex] & ~Current[HandIndex]; }
+
+	void Reset();
+
+	// 한 손 평가 커널(Previous는 히스테리시스에 사용)
+	static EVRGesture EvaluateHand(const FVRHandJoints& Joints, EVRGesture PreviousGestures, const FVRGestureThresholds& Thresholds);
+
+	FVRGestureThresholds Thresholds;
+
+private:
+	EVRGesture Current[2] = { EVRGesture::None, EVRGesture::None };
+	EVRGesture Previous[2] = { EVRGesture::None, EVRGesture::None };
+};
@@ -0,0 +1,52 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "VRHandAnimationSubsystem.generated.h"
+
+// 손 메시 애니메이션 예산 관리
+// 1. 로컬 플레이어의 손은 매 프레임 갱신하고 싶다.
+// 2. 원격 플레이어의 손은 거리/중요도에 따라 갱신 주기를 늘리고, 사이 프레임은 보간하고 싶다.
+// 3. 프레임 당 평가할 수 있는 본 개수(예산)를 넘지 않게 하고 싶다.
+UCLASS()
+class VRPROJECT_API UVRHandAnimationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// 손 메시 등록/해제
+	void RegisterHand(class USkeletalMeshComponent* HandMesh);
+	void UnregisterHand(class USkeletalMeshComponent* HandMesh);
+
+	// 직전 프레임 통계
+	int32 GetNumEvaluated() const { return NumEvaluated; }
+	int32 GetNumSkipped() const { return NumSkipped; }
+	int32 GetNumInterpolated() const { return NumInterpolated; }
+
+private:
+	struct FHandEntry
+	{
+		TWeakObjectPtr<class USkeletalMeshComponent> Mesh;
+		// 마지막 평가 이후 누적된 시간
+		float AccumulatedDeltaTime = 0.f;
+		// 마지막 평가 이후 지난 프레임 수
+		int32 FramesSinceEvaluation = 0;
+		// 이번 프레임 중요도(클수록 먼저 예산을 받는다)
+		float Significance = 0.f;
+		// 이번 프레임 목표 갱신 주기
+		int32 UpdateInterval = 1;
+		// 사이 프레임 보간 여부
+		bool bInterpolate = false;
+	};
+
+	TArray<FHandEntry> Hands;
+
+	int32 NumEvaluated = 0;
+	int32 NumSkipped = 0;
+	int32 NumInterpolated = 0;
+};
@@ -0,0 +1,43 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "InputCoreTypes.h"
+#include "VRGestureRecognizer.h"
+#include "VRHandTrackingComponent.generated.h"
+
+// 손, 제스처, 시작(true)/종료(false)
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnVRHandGesture, EControllerHand, EVRGesture, bool);
+
+// OpenXR 손 추적 입력
+// 1. 매 프레임 양손 관절 위치를 읽어 제스처(집기/잡기/가리키기)를 인식하고 싶다.
+// 2. 제스처가 시작/종료되면 알려주고 싶다.
+UCLASS(ClassGroup=(VR), meta=(BlueprintSpawnableComponent))
+class VRPROJECT_API UVRHandTrackingComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UVRHandTrackingComponent();
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	// 제스처 시작/종료 이벤트
+	FOnVRHandGesture OnGesture;
+
+	// 현재 제스처
+	EVRGesture GetGestures(EControllerHand Hand) const;
+
+	// 손 추적 사용 여부
+	UPROPERTY(EditAnywhere, Category = "Hand Tracking")
+	bool bUseHandTracking = true;
+
+private:
+	FVRGestureRecognizer Recognizer;
+	FVRHandJoints Joints[2];
+
+	// 기록 중이면 관절 데이터를 저장한다(vr.Gesture.Record)
+	void RecordFrame(float DeltaTime);
+};
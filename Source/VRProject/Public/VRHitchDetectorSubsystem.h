@@ -0,0 +1,98 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/EngineSubsystem.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "VRProject.h"
+#include "VRHitchDetectorSubsystem.generated.h"
+
+// 히치 감지기가 프레임별로 기록하는 기능 목록(VRProject.h의 STAT_VR_* 와 같은 이름)
+enum class EVRFeature : uint8
+{
+	PawnTick,
+	TeleportAim,
+	TeleportBeam,
+	Crosshair,
+	Grabbing,
+	DebugRemoteGrab,
+	Input,
+	Fire,
+	Grab,
+	Warp,
+	RemoteGrabPull,
+	HandAnimation,
+	Significance,
+
+	Count
+};
+
+// 기능 실행 시간을 현재 프레임 기록에 더한다(게임 스레드 전용).
+class VRPROJECT_API FVRFeatureScope
+{
+public:
+	explicit FVRFeatureScope(EVRFeature InFeature);
+	~FVRFeatureScope();
+
+	// 현재 프레임의 기능별 시간(초)
+	static double FrameSeconds[(int32)EVRFeature::Count];
+
+private:
+	EVRFeature Feature;
+	uint64 StartCycles;
+};
+
+// 기능 경로에 stat 카운터, Insights 이벤트, 히치 감지 기록을 한 번에 건다.
+// 예) VR_FEATURE_SCOPE(Crosshair);
+#if !UE_BUILD_SHIPPING
+#define VR_FEATURE_SCOPE(Feature) \
+	SCOPE_CYCLE_COUNTER(STAT_VR_##Feature); \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(VR_##Feature, VRProjectChannel); \
+	FVRFeatureScope VRFeatureScope_##Feature(EVRFeature::Feature)
+#else
+#define VR_FEATURE_SCOPE(Feature) \
+	SCOPE_CYCLE_COUNTER(STAT_VR_##Feature)
+#endif
+
+// 프레임 히치 감지기
+// 1. 매 프레임 기능별 시간을 최근 N 프레임 만큼 기억하고 싶다.
+// 2. 프레임 시간이 예산(헤드셋 주사율 간격, 서버 Tick 간격, HMD가 없으면 고정값)을 넘으면 기억한 프레임들을 파일로 남기고 싶다.
+// 3. 게임 월드에서만 동작하고 싶다(헤드리스 실행과 서버 포함, 에디터 제외).
+UCLASS()
+class VRPROJECT_API UVRHitchDetectorSubsystem : public UEngineSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+private:
+	struct FFrameRecord
+	{
+		uint64 FrameNumber = 0;
+		double FrameMs = 0.0;
+		float FeatureMs[(int32)EVRFeature::Count] = {};
+	};
+
+	// 최근 프레임 기록(링 버퍼)
+	TArray<FFrameRecord> History;
+	int32 HistoryHead = 0;
+	int32 HistoryNum = 0;
+
+	double LastFrameTime = 0.0;
+	double LastDumpTime = 0.0;
+	// 현재 히치 기준(ms), 0이면 아직 주사율을 모른다.
+	double BudgetMs = 0.0;
+	FDelegateHandle EndFrameHandle;
+
+	// 프레임 끝 처리
+	void OnEndFrame();
+	// 게임 월드가 돌고 있는지
+	bool IsArmed() const;
+	// 예산 갱신(vr.Hitch.BudgetMs, 서버 Tick 간격, vr.Hitch.HeadlessBudgetMs 또는 추정한 주사율)
+	void UpdateBudget();
+	// 기억한 프레임을 파일로 저장
+	void DumpHistory(double HitchFrameMs);
+};
@@ -0,0 +1,101 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "VRImpactAudioSubsystem.generated.h"
+
+// 충격량 구간별 소리
+USTRUCT()
+struct FVRImpactSoundTier
+{
+	GENERATED_BODY()
+
+	// 이 충격량 이상일 때 사용
+	UPROPERTY(EditAnywhere, Category = "Impact Audio")
+	float MinImpulse = 0.f;
+	UPROPERTY(EditAnywhere, Category = "Impact Audio")
+	TSoftObjectPtr<class USoundBase> Sound;
+	UPROPERTY(EditAnywhere, Category = "Impact Audio")
+	float VolumeMultiplier = 1.f;
+};
+
+// 던지거나 쏜 물체의 충돌음
+// 1. 상호작용한 물체의 물리 충돌 이벤트를 받아 충격량에 따라 소리를 고르고 싶다.
+// 2. 미리 만들어 둔 공간화 오디오 컴포넌트 풀에서 재생하고 싶다.
+// 3. 프레임당/물체당 동시 재생 수와 거리로 소리를 걸러내고 싶다.
+UCLASS(Config = Game)
+class VRPROJECT_API UVRImpactAudioSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	// 충돌음을 낼 물체 등록(TrackDuration 동안 또는 잠들 때까지)
+	void TrackBody(class UPrimitiveComponent* Body);
+
+	// 충격량 구간별 소리(작은 것부터)
+	UPROPERTY(Config)
+	TArray<FVRImpactSoundTier> ImpactSounds;
+	// 소리 감쇠/공간화 설정(비어 있으면 HRTF 공간화 기본값)
+	UPROPERTY(Config)
+	TSoftObjectPtr<class USoundAttenuation> Attenuation;
+	// 미리 만들어 둘 오디오 컴포넌트 수
+	UPROPERTY(Config)
+	int32 PoolSize = 32;
+	// 프레임당 새로 재생할 수 있는 소리 수
+	UPROPERTY(Config)
+	int32 MaxVoicesPerFrame = 8;
+	// 물체 하나가 동시에 낼 수 있는 소리 수
+	UPROPERTY(Config)
+	int32 MaxVoicesPerObject = 1;
+	// 같은 물체가 다시 소리 낼 수 있는 최소 간격
+	UPROPERTY(Config)
+	float MinRetriggerInterval = 0.08f;
+	// 이 거리보다 멀면 재생하지 않는다.
+	UPROPERTY(Config)
+	float MaxAudibleDistance = 3000.f;
+	// 이 충격량보다 약하면 재생하지 않는다.
+	UPROPERTY(Config)
+	float MinImpulse = 200.f;
+	// 등록 후 추적 시간
+	UPROPERTY(Config)
+	float TrackDuration = 10.f;
+
+private:
+	struct FTrackedBody
+	{
+		float TrackEndTime = 0.f;
+		float LastPlayTime = -1.f;
+		bool bPrevNotifyRigidBodyCollision = false;
+	};
+
+	// 오디오 컴포넌트 풀
+	UPROPERTY(Transient)
+	TArray<class UAudioComponent*> Pool;
+	// 풀의 각 소리를 낸 물체(물체당 동시 재생 수 계산용)
+	TArray<TWeakObjectPtr<class UPrimitiveComponent>> PoolVoiceOwners;
+
+	TMap<TWeakObjectPtr<class UPrimitiveComponent>, FTrackedBody> TrackedBodies;
+
+	// 소리 에셋 로드 핸들
+	TSharedPtr<struct FStreamableHandle> SoundsHandle;
+
+	// 이번 프레임 통계
+	int32 VoicesRequested = 0;
+	int32 VoicesCulled = 0;
+	int32 VoicesPlayed = 0;
+
+	UFUNCTION()
+	void OnBodyHit(class UPrimitiveComponent* HitComponent, class AActor* OtherActor, class UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
+
+	void UntrackBody(class UPrimitiveComponent* Body, const FTrackedBody& Tracked);
+	// 빈 오디오 컴포넌트 찾기
+	int32 FindFreeVoice() const;
+};
@@ -0,0 +1,86 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "VRMenuSubsystem.generated.h"
+
+// 클래스별 메뉴 위젯 컴포넌트 풀
+USTRUCT()
+struct FVRMenuPool
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<class UWidgetComponent*> FreeComponents;
+};
+
+// 월드 공간 메뉴
+// 1. 메뉴는 상태가 바뀔 때만 다시 그리고 싶다(수동 redraw).
+// 2. 조준선이 위젯 근처에 있을 때만 위젯 상호작용 트레이스를 하고 싶다.
+//    - 근처 검사는 수동 redraw 여부와 상관없이 월드의 모든 월드 공간 위젯을 본다(배치, 스폰, 스트리밍된 레벨).
+//    - 액터가 생긴 뒤에 붙인 위젯 컴포넌트는 RegisterWidgetComponent로 직접 등록한다.
+// 3. 메뉴 위젯은 처음 보여줄 때 만들고, 숨기면 풀에 돌려놓고 싶다.
+UCLASS(Config = Game)
+class VRPROJECT_API UVRMenuSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	// 월드 공간 위젯 컴포넌트 등록(근처 검사 대상, bManualRedraw면 수동 redraw로 바꾼다)
+	void RegisterWidgetComponent(class UWidgetComponent* WidgetComponent, bool bManualRedraw = true);
+	void UnregisterWidgetComponent(class UWidgetComponent* WidgetComponent);
+
+	// 메뉴 보여주기/숨기기(풀 사용)
+	class UWidgetComponent* ShowMenu(TSubclassOf<class UUserWidget> WidgetClass, const FTransform& Transform);
+	void HideMenu(class UWidgetComponent* WidgetComponent);
+
+	// 위젯이 다시 그려지도록 요청
+	void RequestRedraw(const class UUserWidget* Widget);
+
+	// 조준선이 위젯 근처에 있을 때만 상호작용 컴포넌트를 켠다.
+	void UpdateInteraction(class UWidgetInteractionComponent* Interaction);
+
+	// 기본 메뉴 위젯
+	UPROPERTY(Config)
+	TSoftClassPtr<class UUserWidget> MenuWidgetClass;
+	// 위젯 크기 바깥으로 이만큼까지는 근처로 본다.
+	UPROPERTY(Config)
+	float ProximityMargin = 50.f;
+	// 맵에 배치된 위젯도 수동 redraw로 바꿀지
+	UPROPERTY(Config)
+	bool bManualRedrawPlacedWidgets = true;
+
+private:
+	// 근처 검사할 월드 공간 위젯
+	TArray<TWeakObjectPtr<class UWidgetComponent>> WidgetComponents;
+
+	// 클래스별 풀
+	UPROPERTY(Transient)
+	TMap<UClass*, FVRMenuPool> Pools;
+	// 풀 메뉴를 들고 있을 액터
+	UPROPERTY(Transient)
+	AActor* MenuOwner;
+
+	// 상호작용별 마지막 상태(바뀔 때만 다시 그린다)
+	struct FInteractionState
+	{
+		TWeakObjectPtr<class UWidgetComponent> Hovered;
+		FVector2D HitLocation = FVector2D::ZeroVector;
+	};
+	TMap<TWeakObjectPtr<class UWidgetInteractionComponent>, FInteractionState> InteractionStates;
+
+	bool IsNearWidget(const FVector& Start, const FVector& End);
+
+	// 스폰되거나 스트리밍된 액터의 위젯 등록
+	void RegisterActorWidgets(AActor* Actor, bool bManualRedraw);
+	void OnActorSpawned(AActor* Actor);
+	void OnLevelAdded(ULevel* Level, UWorld* World);
+	FDelegateHandle ActorSpawnedHandle;
+	FDelegateHandle LevelAddedHandle;
+};
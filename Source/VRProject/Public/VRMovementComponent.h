@@ -0,0 +1,67 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "VRMovementComponent.generated.h"
+
+// 가벼운 VR 이동
+// 1. VR 사용자는 대부분 텔레포트로 이동하므로 CharacterMovement의 바닥 찾기, 계단 오르기, 네트워크 예측 비용을 줄이고 싶다.
+// 2. 캡슐을 쓸어 이동하고 벽에 닿으면 미끄러지며, 바닥 검사는 캐시해서 필요할 때만 하고 싶다.
+// 3. 텔레포트/워프 중에는 이동을 멈추고 도착하면 바닥 캐시를 버리고 싶다.
+// bUseLeanMovement가 꺼져 있으면 기존 CharacterMovement 그대로 동작한다(폰 클래스마다 선택).
+// 가벼운 이동은 클라이언트 -> 서버 이동 전송(ServerMove)과 시뮬레이션 프록시 보정을 하지 않으므로
+// 서버가 직접 움직이는 폰(스탠드얼론, 리슨 서버 호스트, 서버의 봇)에만 쓰고, 원격 클라이언트의 폰은 항상 CharacterMovement로 처리한다.
+UCLASS()
+class VRPROJECT_API UVRMovementComponent : public UCharacterMovementComponent
+{
+	GENERATED_BODY()
+
+public:
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	// 서버: 원격 클라이언트가 보낸 이동 처리(비용을 게임 모드의 플레이어 예산에 기록)
+	virtual void MoveAutonomous(float ClientTimeStamp, float DeltaTime, uint8 CompressedFlags, const FVector& NewAccel) override;
+
+	// 가벼운 이동 사용 여부
+	UPROPERTY(EditDefaultsOnly, Category = "VR Movement")
+	bool bUseLeanMovement = false;
+	// 바닥 검사 거리(캡슐 바닥 아래로)
+	UPROPERTY(EditDefaultsOnly, Category = "VR Movement")
+	float FloorProbeDistance = 50.f;
+	// 이만큼 움직이면 바닥을 다시 검사한다.
+	UPROPERTY(EditDefaultsOnly, Category = "VR Movement")
+	float FloorRecheckDistance = 25.f;
+	// 움직이지 않아도 이 프레임마다 바닥을 다시 검사한다.
+	UPROPERTY(EditDefaultsOnly, Category = "VR Movement")
+	int32 FloorRecheckFrames = 10;
+
+	// 이 폰에 가벼운 이동을 적용할지(bUseLeanMovement + 서버가 직접 움직이는 폰)
+	bool IsLeanMovementActive() const;
+
+	// 텔레포트/워프 시작과 도착
+	void SetTeleportSuspended(bool bSuspended);
+	void NotifyTeleported();
+
+	// 부하 테스트용: 원을 그리며 계속 걷게 한다.
+	bool bBenchmarkWander = false;
+
+	// 이동 방식별 컴포넌트 1개당 Tick 시간
+	static void ReportTickTimes();
+	static void ResetTickTimes();
+
+private:
+	void LeanMove(float DeltaTime);
+	// 서버의 이동 비용을 컨트롤러별 예산에 기록
+	void RecordServerCost(double Seconds) const;
+	void UpdateFloor();
+
+	// 바닥 캐시
+	bool bFloorValid = false;
+	bool bOnFloor = false;
+	float FloorZ = 0.f;
+	FVector FloorCheckLocation = FVector::ZeroVector;
+	int32 FramesSinceFloorCheck = 0;
+
+	bool bTeleportSuspended = false;
+};
@@ -5,22 +5,53 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
 #include "InputActionValue.h"
+#include "InputTriggers.h"
+#include "Engine/NetSerialization.h"
+#include "VRSignificanceSubsystem.h"
+#include "VRGestureRecognizer.h"
+#include "VRPoolableActor.h"
+#include "VRAimQuerySubsystem.h"
 #include "VRPlayer.generated.h"
 
+// 복제되는 머리/손 자세(액터 기준)
+USTRUCT()
+struct FVRNetPose
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FVector_NetQuantize10 HeadLocation = FVector::ZeroVector;
+	UPROPERTY()
+	FRotator HeadRotation = FRotator::ZeroRotator;
+	UPROPERTY()
+	FVector_NetQuantize10 LeftLocation = FVector::ZeroVector;
+	UPROPERTY()
+	FRotator LeftRotation = FRotator::ZeroRotator;
+	UPROPERTY()
+	FVector_NetQuantize10 RightLocation = FVector::ZeroVector;
+	UPROPERTY()
+	FRotator RightRotation = FRotator::ZeroRotator;
+};
+
 // 1. 사용자의 입력에 따라 앞뒤좌우로 이동하고 싶다.
 // 2. 사용자가 텔레포트 버튼을 눌렀다 떼면 텔레포트 되도록 하고 싶다.
 UCLASS()
-class VRPROJECT_API AVRPlayer : public ACharacter
+class VRPROJECT_API AVRPlayer : public ACharacter, public IVRPoolableActor
 {
 	GENERATED_BODY()
 
+	// 부하 테스트 봇은 입력 액션에 직접 접근한다.
+	friend class AVRBotController;
+
 public:
 	// Sets default values for this character's properties
-	AVRPlayer();
+	AVRPlayer(const FObjectInitializer& ObjectInitializer);
 
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
+	// Called when the actor is removed from the world
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:	
 	// Called every frame
@@ -44,6 +75,12 @@ protected:
 	class USkeletalMeshComponent* LeftHandMesh;
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Motion Controller")
 	class USkeletalMeshComponent* RightHandMesh;
+
+	// 손 메시 에셋(비동기 로드)
+	UPROPERTY(EditDefaultsOnly, Category = "Motion Controller")
+	TSoftObjectPtr<class USkeletalMesh> LeftHandMeshAsset;
+	UPROPERTY(EditDefaultsOnly, Category = "Motion Controller")
+	TSoftObjectPtr<class USkeletalMesh> RightHandMeshAsset;
 	
 public:
 	// 필요속성: 이동속도, 인풋 매핑 컨텍스트, 인풋 액션
@@ -54,13 +91,13 @@ public:
 	float MoveSpeed = 500.f;
 	// Input Mapping Context
 	UPROPERTY(EditDefaultsOnly, Category = "Input")
-	class UInputMappingContext* IMC_VRInput;
+	TSoftObjectPtr<class UInputMappingContext> IMC_VRInput;
 	// Input Action for Move
 	UPROPERTY(EditDefaultsOnly, Category = "Input")
-	class UInputAction* IA_VRMove;
+	TSoftObjectPtr<class UInputAction> IA_VRMove;
 	// Input Action for Look
 	UPROPERTY(EditDefaultsOnly, Category = "Input")
-	class UInputAction* IA_VRLook;
+	TSoftObjectPtr<class UInputAction> IA_VRLook;
 	// 사용할 나이아가라 컴포넌트(LineTrace)
 	UPROPERTY(VisibleAnywhere, Category = "Teleport")
 	class UNiagaraComponent* TeleportCurveTraceComponent;
@@ -80,11 +117,14 @@ public:
 	class UNiagaraComponent* TeleportCircle;
 	// 텔레포트 입력 액션
 	UPROPERTY(EditDefaultsOnly, Category = "Input")
-	class UInputAction* IA_Teleport;
+	TSoftObjectPtr<class UInputAction> IA_Teleport;
 	// 텔레포트 기능 활성화 여부
 	bool bTeleporting = false;
 	// 텔레포트 위치
 	FVector TeleportPos;
+	// 텔레포트 목적지 예측 스트리밍
+	UPROPERTY(VisibleAnywhere, Category = "Teleport")
+	class UVRTeleportStreamingComponent* TeleportStreaming;
 
 	
 	// 텔레포트 버튼을 눌렀을 때 처리할 함수
@@ -97,8 +137,10 @@ public:
 	void TeleportDrawStraight();
 	// 텔레포트 선과 충돌체크 함수
 	bool CheckHitTeleport(FVector LastPos, FVector& CurrentPos);
+	// 충돌 결과로 텔레포트 위치 갱신(바닥일 때만)
+	void ApplyTeleportHit(bool bHit, const FHitResult& HitInfo, FVector& CurrentPos);
 	// 충돌 처리 함수
-	bool HitTest(FVector LastPos, FVector CurrentPos, FHitResult& HitInfo);
+	bool HitTest(FVector LastPos, FVector CurrentPos, FHitResult& HitInfo, ECollisionChannel TraceChannel);
 	
 	// ============================================================================================
 
@@ -123,6 +165,8 @@ private:
 	int32 VertexCount = 40;
 	// 점을 기억할 배열
 	TArray<FVector> Vertices;
+	// 조준 질의 결과를 기다리는 곡선(자르기 전)
+	TArray<FVector> PendingVertices;
 
 	void TeleportDrawCurve();
 	
@@ -146,10 +190,14 @@ private:
 	// 워프할 때 필요한 시간
 	UPROPERTY(EditAnywhere, Category = "Teleport", meta=(AllowPrivateAccess = true))
 	float WarpTime = 0.2f;
+	// 워프 시작 위치
+	FVector WarpStartPos;
 
 	// 워프를 수행할 함수
 	UFUNCTION()
 	void DoWarp();
+	// 워프 도착(또는 중단): 꺼 둔 이동 모드와 충돌체를 되돌린다.
+	void FinishWarp();
 	
 	// ============================================================================================
 
@@ -159,7 +207,7 @@ private:
 	// ============================================================================================
 
 	UPROPERTY(EditDefaultsOnly, Category = "Input", meta=(AllowPrivateAccess = true))
-	class UInputAction* IA_Fire;
+	TSoftObjectPtr<class UInputAction> IA_Fire;
 	// 집게손가락 표시할 모션 컨트롤러
 	UPROPERTY(VisibleAnywhere, Category = "Motion Controller", meta=(AllowPrivateAccess = true))
 	class UMotionControllerComponent* RightAim;
@@ -175,12 +223,25 @@ private:
 
 	// 크로스헤어 파일(크로스헤어 공장)
 	UPROPERTY(EditAnywhere, Category = "Crosshair", meta=(AllowPrivateAccess = true))
-	TSubclassOf<AActor> CrosshairFactory;
+	TSoftClassPtr<AActor> CrosshairFactory;
 	// 크로스헤어 인스턴스
 	UPROPERTY()
 	AActor* Crosshair;
 	// 크로스헤어 그리기
 	void DrawCrosshair();
+	// 충돌 결과로 크로스헤어 위치/크기 갱신
+	void ApplyCrosshair(bool bHit, const FHitResult& HitInfo, const FVector& StartPos, const FVector& EndPos);
+
+	// 총 맞은 곳 표시(액터 풀에서 꺼내 쓴다)
+	UPROPERTY(EditAnywhere, Category = "Crosshair", meta=(AllowPrivateAccess = true))
+	TSoftClassPtr<AActor> ImpactMarkerFactory;
+	// 표시 유지 시간
+	UPROPERTY(EditAnywhere, Category = "Crosshair", meta=(AllowPrivateAccess = true))
+	float ImpactMarkerLifetime = 2.0f;
+	// 원격 클라이언트에서 직접 세는 충돌 표시가 사라지는 시각
+	TArray<float> ImpactMarkerExpiry;
+	// 플레이어 예산 안이면 충돌 표시 하나를 쓴다.
+	bool TryUseImpactMarker();
 
 	float NiagaraTime = 0.1f;
 	float CurrentNiagaraTime = 0.f;
@@ -194,7 +255,7 @@ private:
 
 	// 잡기 입력 액션
 	UPROPERTY(EditDefaultsOnly, Category = "Input", meta=(AllowPrivateAccess=true))
-	class UInputAction* IA_Grab;
+	TSoftObjectPtr<class UInputAction> IA_Grab;
 	// 잡을 범위
 	UPROPERTY(EditAnywhere, Category = "Grab")
 	float GrabRange = 100.f;
@@ -234,7 +295,7 @@ private:
 	// ============================================================================================
 
 	UPROPERTY(EditDefaultsOnly, Category="Haptic")
-	class UHapticFeedbackEffect_Curve* HF_Fire;
+	TSoftObjectPtr<class UHapticFeedbackEffect_Curve> HF_Fire;
 	
 	// ============================================================================================
 
@@ -250,7 +311,7 @@ protected:
 	
 public:
 	UPROPERTY(EditDefaultsOnly, Category="Input")
-	class UInputMappingContext* IMC_Hand;
+	TSoftObjectPtr<class UInputMappingContext> IMC_Hand;
 
 	
 	// 원격 잡기
@@ -278,6 +339,154 @@ public:
 	void RemoteGrab();
 	// 시각화 처리 함수
 	void DrawDebugRemoteGrab();
+	void ApplyDebugRemoteGrab(bool bHit, const FHitResult& HitInfo, const FVector& StartPos);
+
+public:
+	// 묶음 조준 질의 요청(묶지 않을 때는 false, 호출한 쪽이 바로 트레이스 한다)
+	bool SubmitAimQuery(EVRAimQuery Kind, TArrayView<const FVector> Points, float Radius, ECollisionChannel TraceChannel);
+	// 묶음 조준 질의 결과(UVRAimQuerySubsystem이 PostPhysics 전에 호출)
+	void OnAimQueryResult(EVRAimQuery Kind, int32 HitSegment, const FHitResult& HitInfo, TArrayView<const FVector> Points);
+	// 원격 프록시로 바꿀 때 넘겨줄 머리/손 월드 위치
+	void GetTrackedPose(FTransform& OutHead, FTransform& OutLeftHand, FTransform& OutRightHand) const;
+
+private:
 	
 	// ============================================================================================
+
+
+protected:
+	// 손 추적
+	// ============================================================================================
+	// 손 추적 제스처로도 잡기/총쏘기를 하고 싶다.
+
+	UPROPERTY(VisibleAnywhere, Category = "Hand Tracking")
+	class UVRHandTrackingComponent* HandTracking;
+
+	// 제스처 처리 함수
+	void OnHandGesture(EControllerHand Hand, EVRGesture Gesture, bool bStarted);
+
+	// ============================================================================================
+
+
+private:
+	// 에셋 비동기 로드
+	// ============================================================================================
+	// 입력 관련 에셋을 먼저 받아서 바로 조작 가능하게 하고, 손 메시는 로드가 끝나는 대로 보이게 하고 싶다.
+
+	// 입력/상호작용 번들(높은 우선순위)
+	TSharedPtr<struct FStreamableHandle> InputAssetsHandle;
+	// 손 메시 번들
+	TSharedPtr<struct FStreamableHandle> HandMeshAssetsHandle;
+	// 입력 에셋 로드 완료 여부
+	bool bInputAssetsReady = false;
+	// 현재 InputComponent에 액션이 바인딩 되었는지 여부
+	bool bInputActionsBound = false;
+	// 로드 요청 시각(측정용)
+	double AssetLoadStartTime = 0.0;
+
+	// 번들 로드 요청
+	void RequestAssetLoads();
+	// 입력 번들 로드 완료 처리
+	void OnInputAssetsLoaded();
+	// 손 메시 번들 로드 완료 처리
+	void OnHandMeshesLoaded();
+	// 입력 액션 바인딩
+	void BindInputActions(class UEnhancedInputComponent* InputSystem);
+	// 매핑 컨텍스트 등록
+	void AddInputMappingContexts();
+
+	// ============================================================================================
+
+
+public:
+	// 중요도
+	// ============================================================================================
+	// 원격 플레이어는 중요도 단계에 따라 하는 일을 줄이고 싶다.
+
+	// 중요도 단계 변경(UVRSignificanceSubsystem에서 호출)
+	void SetSignificanceTier(EVRSignificanceTier NewTier);
+	EVRSignificanceTier GetSignificanceTier() const { return SignificanceTier; }
+
+private:
+	// 현재 중요도 단계
+	EVRSignificanceTier SignificanceTier = EVRSignificanceTier::Local;
+	// 단계별 Tick 주기(초)
+	UPROPERTY(EditDefaultsOnly, Category = "Significance", meta=(AllowPrivateAccess = true))
+	float NearRemoteTickInterval = 1.f / 30.f;
+	UPROPERTY(EditDefaultsOnly, Category = "Significance", meta=(AllowPrivateAccess = true))
+	float FarRemoteTickInterval = 0.1f;
+	UPROPERTY(EditDefaultsOnly, Category = "Significance", meta=(AllowPrivateAccess = true))
+	float CulledTickInterval = 0.5f;
+
+	// ============================================================================================
+
+
+public:
+	// 봇 입력
+	// ============================================================================================
+	// AI 컨트롤러에는 LocalPlayer가 없어서 Enhanced Input 주입을 쓸 수 없으므로, 바인딩과 같은 함수로 직접 전달한다.
+
+	// 입력 액션 주입
+	void InjectInputAction(const class UInputAction* Action, ETriggerEvent TriggerEvent, const FInputActionValue& Value);
+	// HMD/컨트롤러 트래킹 대신 상대 위치/회전을 직접 설정
+	void SetTrackingPose(const FTransform& Head, const FTransform& Left, const FTransform& Right);
+
+	// ============================================================================================
+
+
+public:
+	// 폰 풀
+	// ============================================================================================
+	// 접속/종료 때 폰을 파괴하지 않고 재사용하므로, 풀에 돌려놓을 때 상태를 모두 초기화하고 싶다.
+
+	virtual void OnAcquiredFromPool_Implementation() override;
+	virtual void OnReleasedToPool_Implementation() override;
+
+private:
+	// 월드 서브시스템(손 애니메이션, 중요도) 등록/해제
+	void RegisterWithWorldSystems();
+	void UnregisterFromWorldSystems();
+	bool bRegisteredWithWorldSystems = false;
+	// 크로스헤어를 액터 풀에서 꺼낸다.
+	void AcquireCrosshair();
+
+	// ============================================================================================
+
+
+public:
+	// 원격 프록시
+	// ============================================================================================
+	// 머리/손 자세를 다른 플레이어에게 복제하고, 멀리 있는 원격 플레이어는 UVRRemoteProxySubsystem의 프록시로 그리고 싶다.
+
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	// 프록시로 그릴지 전환(중요도 단계에서 호출)
+	void SetProxyMode(bool bEnable);
+	bool IsProxyMode() const { return ProxyIndex != INDEX_NONE; }
+
+private:
+	// 복제되는 자세(조종하는 클라이언트는 받지 않는다)
+	UPROPERTY(ReplicatedUsing = OnRep_NetPose)
+	FVRNetPose NetPose;
+	bool bHasNetPose = false;
+	UFUNCTION()
+	void OnRep_NetPose();
+
+	// 조종하는 클라이언트 -> 서버 자세 전송
+	UFUNCTION(Server, Unreliable)
+	void ServerSetNetPose(const FVRNetPose& Pose);
+
+	// 자세 전송 간격(= 프록시 보간 시간)
+	UPROPERTY(EditDefaultsOnly, Category = "Remote Proxy", meta=(AllowPrivateAccess = true))
+	float NetPoseInterval = 0.1f;
+	float NetPoseTime = 0.f;
+	// 로컬 폰: 일정 간격으로 자세를 보낸다.
+	void UpdateNetPose(float DeltaTime);
+	// 프록시에 넘길 월드 기준 자세(받은 자세가 없으면 지금 컴포넌트 위치)
+	struct FVRProxyPose GetProxyPose() const;
+
+	// 프록시 번호(INDEX_NONE이면 전체 폰으로 그린다)
+	int32 ProxyIndex = INDEX_NONE;
+
+	// ============================================================================================
 };
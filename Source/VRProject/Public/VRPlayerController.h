@@ -0,0 +1,19 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/PlayerController.h"
+#include "VRPlayerController.generated.h"
+
+// 접속 종료 시 폰을 파괴하지 않고 게임 모드의 폰 풀에 돌려놓는다.
+// vr.Session.ClientLifetime이 설정된 클라이언트(vr.Session.ChurnClients가 띄운 프로세스)는 그 시간 뒤 종료한다.
+UCLASS()
+class VRPROJECT_API AVRPlayerController : public APlayerController
+{
+	GENERATED_BODY()
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void PawnLeavingGame() override;
+};
@@ -0,0 +1,27 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "VRPoolableActor.generated.h"
+
+UINTERFACE(MinimalAPI, Blueprintable)
+class UVRPoolableActor : public UInterface
+{
+	GENERATED_BODY()
+};
+
+// 액터 풀에서 꺼내거나 돌려놓을 때 상태를 초기화하고 싶은 액터가 구현한다.
+class VRPROJECT_API IVRPoolableActor
+{
+	GENERATED_BODY()
+
+public:
+	// 풀에서 꺼낼 때(BeginPlay 대신)
+	UFUNCTION(BlueprintNativeEvent, Category = "Actor Pool")
+	void OnAcquiredFromPool();
+	// 풀에 돌려놓을 때(Destroy 대신)
+	UFUNCTION(BlueprintNativeEvent, Category = "Actor Pool")
+	void OnReleasedToPool();
+};
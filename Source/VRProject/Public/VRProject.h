@@ -3,4 +3,41 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Trace/Trace.h"
 
+DECLARE_LOG_CATEGORY_EXTERN(LogVRProject, Log, All);
+
+// 프로젝트 전용 트레이스 채널(DefaultEngine.ini의 DefaultChannelResponses와 같아야 한다)
+// 텔레포트 곡선(기본 무시, TeleportFloor 프로필과 정적인 벽(BlockAll, InvisibleWall)만 막는다)
+#define ECC_Teleport ECC_GameTraceChannel2
+// 잡을 수 있는 물체
+#define ECC_Grabbable ECC_GameTraceChannel3
+// 크로스헤어/총쏘기
+#define ECC_Hitscan ECC_GameTraceChannel4
+
+// 텔레포트 가능한 바닥 충돌 프로필(DefaultEngine.ini의 Profiles와 같아야 한다)
+#define VR_PROFILE_TeleportFloor TEXT("TeleportFloor")
+
+DECLARE_STATS_GROUP(TEXT("VRProject"), STATGROUP_VRProject, STATCAT_Advanced);
+
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(VRPROJECT_API, VRProject);
+
+// Unreal Insights 전용 채널(-trace=cpu,VRProject)
+UE_TRACE_CHANNEL_EXTERN(VRProjectChannel, VRPROJECT_API);
+
+// 기능별 사이클 카운터(VR_FEATURE_SCOPE에서 사용)
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Pawn Tick"), STAT_VR_PawnTick, STATGROUP_VRProject, VRPROJECT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Teleport Aim"), STAT_VR_TeleportAim, STATGROUP_VRProject, VRPROJECT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Teleport Beam"), STAT_VR_TeleportBeam, STATGROUP_VRProject, VRPROJECT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Crosshair"), STAT_VR_Crosshair, STATGROUP_VRProject, VRPROJECT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Grabbing"), STAT_VR_Grabbing, STATGROUP_VRProject, VRPROJECT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Debug Remote Grab"), STAT_VR_DebugRemoteGrab, STATGROUP_VRProject, VRPROJECT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Input Handlers"), STAT_VR_Input, STATGROUP_VRProject, VRPROJECT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Fire"), STAT_VR_Fire, STATGROUP_VRProject, VRPROJECT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Grab/Release"), STAT_VR_Grab, STATGROUP_VRProject, VRPROJECT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Warp Timer"), STAT_VR_Warp, STATGROUP_VRProject, VRPROJECT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Remote Grab Pull"), STAT_VR_RemoteGrabPull, STATGROUP_VRProject, VRPROJECT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Hand Animation Budget"), STAT_VR_HandAnimation, STATGROUP_VRProject, VRPROJECT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Significance"), STAT_VR_Significance, STATGROUP_VRProject, VRPROJECT_API);
@@ -0,0 +1,27 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/StaticMeshActor.h"
+#include "VRPoolableActor.h"
+#include "VRPropActor.generated.h"
+
+// 잡기 위해 실제 액터로 승격된 소품(잡았다 놓기 전까지는 물리를 켜지 않는다)
+// 액터 풀에서 꺼내 쓰고, 잠들면 UVRPropFieldSubsystem이 다시 인스턴스로 돌려놓는다.
+UCLASS()
+class VRPROJECT_API AVRPropActor : public AStaticMeshActor, public IVRPoolableActor
+{
+	GENERATED_BODY()
+
+public:
+	AVRPropActor();
+
+	virtual void OnAcquiredFromPool_Implementation() override;
+	virtual void OnReleasedToPool_Implementation() override;
+
+	// 원래 소품 번호
+	int32 PropItemIndex = INDEX_NONE;
+	// 승격된 시간
+	float PromotedTime = 0.f;
+};
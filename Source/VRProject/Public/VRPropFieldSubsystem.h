@@ -0,0 +1,82 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "VRPropFieldSubsystem.generated.h"
+
+// 대량의 잡을 수 있는 소품
+// 1. 수만 개의 작은 소품을 액터 없이 인스턴스 메시와 배열(SoA)로 들고 있고 싶다.
+// 2. 손이나 원거리 잡기가 고른 소품만 실제 액터로 승격하고 싶다. 물리는 잡았다 놓을 때 켜진다.
+// 3. 승격된 소품이 잠들거나 잡히지 않으면 다시 인스턴스로 돌려놓고 싶다.
+UCLASS(Config = Game)
+class VRPROJECT_API UVRPropFieldSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	// 소품 추가(균일 스케일만 사용)
+	void AddItems(class UStaticMesh* Mesh, const TArray<FTransform>& Transforms);
+	int32 GetNumItems() const { return Positions.Num(); }
+
+	// 구 안에서 가장 가까운 소품을 승격한다.
+	class AVRPropActor* PromoteNearest(const FVector& Location, float Radius);
+	// 구를 쓸어 가며 처음 닿는 소품을 승격한다.
+	class AVRPropActor* PromoteAlongSweep(const FVector& Start, const FVector& End, float Radius);
+
+	// 메모리/프레임 시간 로그
+	void Report();
+	void ResetFrameTimes();
+
+	// 공간 격자 크기
+	UPROPERTY(Config)
+	float CellSize = 100.f;
+	// 승격 후 최소 유지 시간(바로 잠들어 다시 강등되는 것 방지)
+	UPROPERTY(Config)
+	float MinPromotedTime = 1.f;
+	// 동시에 승격할 수 있는 최대 수
+	UPROPERTY(Config)
+	int32 MaxPromoted = 64;
+
+private:
+	// 소품 데이터(SoA)
+	TArray<FVector3f> Positions;
+	TArray<FQuat4f> Rotations;
+	TArray<float> Scales;
+	TArray<uint16> MeshIndices;
+	TArray<int32> InstanceIndices;
+	TBitArray<> Promoted;
+
+	// 공간 격자: 칸 -> 소품 번호
+	TMap<FIntVector, TArray<int32>> Cells;
+
+	// 메시별 인스턴스 컴포넌트
+	UPROPERTY(Transient)
+	TArray<class UStaticMesh*> Meshes;
+	UPROPERTY(Transient)
+	TArray<class UHierarchicalInstancedStaticMeshComponent*> MeshComponents;
+	TArray<float> MeshRadii;
+	UPROPERTY(Transient)
+	AActor* InstanceOwner;
+
+	// 승격된 소품
+	UPROPERTY(Transient)
+	TArray<class AVRPropActor*> PromotedActors;
+
+	// 측정값
+	double FrameSeconds = 0.0;
+	int64 FrameCount = 0;
+
+	FIntVector GetCell(const FVector& Location) const;
+	FIntVector GetItemCell(int32 Item) const;
+	int32 FindOrAddMesh(class UStaticMesh* Mesh);
+	FTransform GetItemTransform(int32 Item) const;
+	class AVRPropActor* Promote(int32 Item);
+	void Demote(class AVRPropActor* Actor);
+};
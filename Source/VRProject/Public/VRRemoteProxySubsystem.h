@@ -0,0 +1,99 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "VRRemoteProxySubsystem.generated.h"
+
+// 원격 플레이어 자세(머리, 양손)
+struct FVRProxyPose
+{
+	FVector3f HeadLocation = FVector3f::ZeroVector;
+	FQuat4f HeadRotation = FQuat4f::Identity;
+	FVector3f LeftLocation = FVector3f::ZeroVector;
+	FQuat4f LeftRotation = FQuat4f::Identity;
+	FVector3f RightLocation = FVector3f::ZeroVector;
+	FQuat4f RightRotation = FQuat4f::Identity;
+
+	FVRProxyPose() = default;
+	FVRProxyPose(const FTransform& Head, const FTransform& Left, const FTransform& Right);
+
+	static FVRProxyPose Interpolate(const FVRProxyPose& A, const FVRProxyPose& B, float Alpha);
+};
+
+// 가벼운 원격 플레이어 표현
+// 1. 멀리 있는 원격 플레이어(중요도 FarRemote/Culled)는 폰의 손/빔 대신 머리/손 인스턴스 메시와 자세 배열(SoA)로 그리고 싶다.
+// 2. 폰이 복제 받은 자세(AVRPlayer::NetPose) 사이를 보간해서 부드럽게 움직이고 싶다.
+// 3. 가까워지거나 빙의되어 로컬 폰이 되면 다시 전체 폰으로 그리고 싶다(AVRPlayer::SetProxyMode).
+// 4. 폰 1개의 메모리와 프록시가 그 위에 더하는 메모리를 보고 싶다.
+//    프록시 모드에서도 폰은 그대로 남으므로 메모리는 줄지 않는다. 줄어드는 것은 손 메시 그리기와 애니메이션 비용이다.
+// 서버는 그리지 않으므로 클라이언트(와 스탠드얼론)에서만 쓴다.
+UCLASS(Config = Game)
+class VRPROJECT_API UVRRemoteProxySubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	// 프록시 추가/제거(Owner가 없으면 측정용 프록시)
+	int32 AddProxy(const FVRProxyPose& Pose, AActor* Owner = nullptr);
+	void RemoveProxy(int32 Proxy);
+	int32 GetNumProxies() const { return NumActive; }
+
+	// 새 자세를 받으면 지금 보이는 자세에서 새 자세까지 보간한다.
+	void PushPose(int32 Proxy, const FVRProxyPose& Pose);
+
+	// 측정용: 주인 없는 프록시에 가짜 자세를 계속 보내 보간을 돌린다.
+	void SetSimulatedMotion(bool bEnable) { bSimulatedMotion = bEnable; }
+
+	// 폰 1개 메모리와 프록시 1개가 더하는 메모리 로그
+	void Report();
+	// 액터와 액터 소유 오브젝트(컴포넌트, 애님 인스턴스 등)의 메모리 합
+	static SIZE_T GetActorFootprint(AActor* Actor, TMap<FName, SIZE_T>* OutBreakdown = nullptr);
+
+	UPROPERTY(Config)
+	TSoftObjectPtr<class UStaticMesh> HeadMesh;
+	UPROPERTY(Config)
+	TSoftObjectPtr<class UStaticMesh> HandMesh;
+	UPROPERTY(Config)
+	float HeadScale = 0.25f;
+	UPROPERTY(Config)
+	float HandScale = 0.1f;
+	// 자세를 받는 간격(= 보간 시간)
+	UPROPERTY(Config)
+	float PoseInterval = 0.1f;
+
+private:
+	// 프록시 데이터(SoA): 머리 인스턴스 = 프록시 번호, 손 인스턴스 = 프록시 번호 * 2 (+1)
+	TArray<FVRProxyPose> FromPoses;
+	TArray<FVRProxyPose> ToPoses;
+	TArray<float> FromTimes;
+	TArray<TWeakObjectPtr<AActor>> Owners;
+	TBitArray<> Active;
+	TArray<int32> FreeProxies;
+	int32 NumActive = 0;
+	bool bPosesDirty = false;
+	bool bSimulatedMotion = false;
+	float SimulatedPoseTime = 0.f;
+
+	// 매 프레임 옮기므로 트리를 다시 만드는 HISM 대신 ISM을 쓴다.
+	UPROPERTY(Transient)
+	class UInstancedStaticMeshComponent* HeadComponent;
+	UPROPERTY(Transient)
+	class UInstancedStaticMeshComponent* HandComponent;
+	UPROPERTY(Transient)
+	AActor* InstanceOwner;
+
+	// 인스턴스 갱신용 임시 배열(재사용)
+	TArray<FTransform> HeadTransforms;
+	TArray<FTransform> HandTransforms;
+
+	bool CreateComponents();
+	FVRProxyPose GetCurrentPose(int32 Proxy, float Now) const;
+	void SimulateMotion(float Now);
+};
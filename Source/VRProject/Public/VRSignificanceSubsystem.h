@@ -0,0 +1,56 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "VRSignificanceSubsystem.generated.h"
+
+// VR 폰 중요도 단계
+UENUM(BlueprintType)
+enum class EVRSignificanceTier : uint8
+{
+	// 로컬 플레이어: 모든 기능 처리
+	Local,
+	// 가까운 원격 플레이어
+	NearRemote,
+	// 먼 원격 플레이어
+	FarRemote,
+	// 보이지 않거나 너무 먼 원격 플레이어
+	Culled,
+
+	Count UMETA(Hidden)
+};
+
+// 1. 매 프레임 각 VR 폰의 중요도 단계를 분류하고 싶다.
+// 2. 단계별로 폰이 하는 일(Tick 주기, 트레이스, 빔 갱신)을 줄이고 싶다.
+// 3. 단계별 폰 1개당 게임 스레드 시간을 측정하고 싶다.
+UCLASS()
+class VRPROJECT_API UVRSignificanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// 폰 등록/해제
+	void RegisterPawn(class AVRPlayer* Pawn);
+	void UnregisterPawn(class AVRPlayer* Pawn);
+
+	// 폰 Tick 시간 기록
+	void RecordTickTime(EVRSignificanceTier Tier, double Seconds);
+
+	// 단계별 폰 수와 폰 1개당 평균 Tick 시간을 로그로 남긴다.
+	void ReportTickTimes();
+	// 측정값 초기화
+	void ResetTickTimes();
+
+private:
+	TArray<TWeakObjectPtr<class AVRPlayer>> Pawns;
+
+	// 단계별 측정값
+	double TierTickSeconds[(int32)EVRSignificanceTier::Count] = {};
+	int64 TierTickCount[(int32)EVRSignificanceTier::Count] = {};
+	int32 TierPawnCount[(int32)EVRSignificanceTier::Count] = {};
+};
@@ -0,0 +1,55 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// 여러 개의 곡선을 한 번에 계산하기 위한 입력/출력(SoA)
+// - 개수는 SIMD 폭(4)에 맞춰 채워지고, 남는 칸은 0으로 계산된다.
+struct VRPROJECT_API FVRArcBatch
+{
+	TArray<float> PosX, PosY, PosZ;
+	TArray<float> VelX, VelY, VelZ;
+
+	void SetNum(int32 InNum);
+	int32 Num() const { return NumArcs; }
+	int32 PaddedNum() const { return PosX.Num(); }
+	void Set(int32 Index, const FVector3f& Position, const FVector3f& Velocity);
+
+private:
+	int32 NumArcs = 0;
+};
+
+// 곡선 점(SoA): Step번째 점은 [Step * PaddedNum + Arc]
+struct VRPROJECT_API FVRArcBatchPoints
+{
+	TArray<float> X, Y, Z;
+	int32 PaddedNum = 0;
+	int32 StepCount = 0;
+
+	FVector3f Get(int32 Arc, int32 Step) const
+	{
+		const int32 Index = Step * PaddedNum + Arc;
+		return FVector3f(X[Index], Y[Index], Z[Index]);
+	}
+};
+
+// 텔레포트/워프/원거리 잡기/던지기 계산
+// - 월드, 컴포넌트, 프레임 시간에 의존하지 않고 고정 시간 간격으로 계산한다.
+// - 같은 입력이면 항상 같은 결과가 나오므로 따로 떼어 테스트/측정할 수 있다.
+struct VRPROJECT_API FVRSimulation
+{
+	// 곡선 텔레포트: Start부터 VertexCount개의 점(v = v0 + gt, P = P0 + vt)
+	static void SimulateArc(const FVector& Start, const FVector& Velocity, float Gravity, float StepTime, int32 VertexCount, TArray<FVector>& OutPoints);
+	// 여러 곡선을 SIMD로 한 번에 계산(각 곡선 StepCount개의 점, 시작점 포함)
+	static void SimulateArcs(const FVRArcBatch& Arcs, float Gravity, float StepTime, int32 StepCount, FVRArcBatchPoints& OutPoints);
+
+	// 워프: 시작점에서 경과 시간 비율만큼 목적지로 간 위치(목적지가 준비되지 않았으면 HoldAlpha에서 멈춘다).
+	static FVector StepWarp(const FVector& Start, const FVector& End, float Elapsed, float Duration, float HoldAlpha, bool bDestinationReady);
+
+	// 원거리 잡기: 물체를 목표 쪽으로 끌어온다. 도착하면 목표 위치로 맞추고 true.
+	static bool StepPull(FVector& Position, const FVector& Target, float PullSpeed, float StepTime, float ArriveDistance);
+
+	// 던지기: 마지막 프레임 회전 변화량으로 각속도(rad/s) 계산
+	static FVector ThrowAngularVelocity(const FQuat& DeltaRotation, float DeltaTime);
+};
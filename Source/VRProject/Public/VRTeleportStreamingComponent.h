@@ -0,0 +1,67 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "WorldPartition/WorldPartitionStreamingSource.h"
+#include "VRTeleportStreamingComponent.generated.h"
+
+// 텔레포트 목적지 예측 스트리밍
+// 1. 텔레포트 조준 중에는 목적지를 높은 우선순위 스트리밍 소스로 월드 파티션에 알려주고 싶다.
+// 2. 워프는 목적지 셀이 로드될 때까지 도착을 미루고 싶다.
+// 3. 도착 직후 프레임의 히치를 측정하고 싶다.
+UCLASS(ClassGroup=(VR), meta=(BlueprintSpawnableComponent))
+class VRPROJECT_API UVRTeleportStreamingComponent : public UActorComponent, public IWorldPartitionStreamingSourceProvider
+{
+	GENERATED_BODY()
+
+public:
+	UVRTeleportStreamingComponent();
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+public:
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	// IWorldPartitionStreamingSourceProvider
+	virtual bool GetStreamingSource(FWorldPartitionStreamingSource& StreamingSource) override;
+
+	// 예상 목적지 설정/해제
+	void SetPredictedDestination(const FVector& Destination);
+	void ClearPrediction();
+	bool HasPrediction() const { return bHasPrediction; }
+
+	// 예상 목적지 주변 셀이 모두 활성화 되었는지 여부(월드 파티션이 아니면 항상 true)
+	bool IsDestinationStreamed() const;
+
+	// 도착 처리: 예측을 해제하고 히치 측정을 시작한다.
+	void NotifyArrived();
+
+	// 워프 도착을 기다릴 최대 시간
+	UPROPERTY(EditAnywhere, Category = "Streaming")
+	float MaxWarpStreamingWait = 2.f;
+	// 목적지가 로드되지 않았을 때 멈춰서 기다릴 워프 진행률
+	UPROPERTY(EditAnywhere, Category = "Streaming")
+	float WarpStreamingHoldAlpha = 0.9f;
+	// 목적지 주변 질의 반경
+	UPROPERTY(EditAnywhere, Category = "Streaming")
+	float DestinationQueryRadius = 1000.f;
+	// 도착 후 히치를 측정할 프레임 수
+	UPROPERTY(EditAnywhere, Category = "Streaming")
+	int32 HitchTrackFrames = 60;
+	// 히치로 판단할 프레임 시간(ms)
+	UPROPERTY(EditAnywhere, Category = "Streaming")
+	float HitchThresholdMs = 11.1f;
+
+private:
+	bool bHasPrediction = false;
+	FVector PredictedDestination = FVector::ZeroVector;
+
+	// 도착 후 히치 측정
+	int32 FramesToTrack = 0;
+	int32 HitchCount = 0;
+	float WorstFrameMs = 0.f;
+};